@@ -0,0 +1,353 @@
+#include "bench.h"
+#include <patterns.h>
+#include <fixmath.h>
+#include "tetris/tetris_ai.h"
+#include <preview.h>
+#include <algorithm>
+
+#define STACK_FILL 0xA5
+
+// Nanoseconds since `startCycles`, from the per-core cycle counter
+static inline uint32_t elapsedNs(uint32_t startCycles) {
+  return (uint64_t)(ESP.getCycleCount() - startCycles) * 1000 / ESP.getCpuFreqMHz();
+}
+
+// Stack depth is measured by painting the stack below the caller's frame,
+// running the pattern from the same frame and looking for the deepest
+// byte it overwrote. Both helpers must stay out of line so their arrays
+// sit exactly where the pattern's frames will go. Reading the array that
+// was never written is the point, hence the pragmas.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wunused-but-set-variable"
+static void __attribute__((noinline)) paintStack() {
+  volatile uint8_t area[BENCH_STACK_PAINT];
+  for (size_t i = 0; i < BENCH_STACK_PAINT; i++) {
+    area[i] = STACK_FILL;
+  }
+}
+
+static uint32_t __attribute__((noinline)) stackUsed() {
+  volatile uint8_t area[BENCH_STACK_PAINT];
+  size_t untouched = 0;
+  while (untouched < BENCH_STACK_PAINT && area[untouched] == STACK_FILL) {
+    untouched++;
+  }
+  return BENCH_STACK_PAINT - untouched;
+}
+#pragma GCC diagnostic pop
+
+bool benchPattern(size_t index, CRGB* leds, uint16_t frames, uint32_t seed, BenchResult* result) {
+  if (index >= PATTERN_COUNT || frames == 0 || frames > BENCH_MAX_FRAMES) {
+    return false;
+  }
+  uint32_t* samples = (uint32_t*)malloc(frames * sizeof(uint32_t));
+  if (!samples) {
+    return false;
+  }
+  memset(result, 0, sizeof(*result));
+  result->frames = frames;
+
+  // Painting needs the whole area free, with some margin for the pattern
+  // itself; the render task normally has plenty
+  bool measureStack = uxTaskGetStackHighWaterMark(nullptr) > BENCH_STACK_PAINT + 1024;
+
+  randomSeed(seed);
+  random16_set_seed(seed);
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
+
+  // Heap figures are free-heap differences, so on the device they also
+  // catch whatever the web server allocates meanwhile
+  uint32_t freeBefore = ESP.getFreeHeap();
+  uint32_t lowestFree = freeBefore;
+  beginPattern(index);
+  g_frameDeltaMs = 0;
+
+  for (uint16_t f = 0; f < frames; f++) {
+    setFrameDelay(1);
+    if (measureStack) {
+      paintStack();
+    }
+    uint32_t start = ESP.getCycleCount();
+    g_patternList[index].func(leds);
+    samples[f] = elapsedNs(start);
+    if (measureStack) {
+      result->stackBytes = max(result->stackBytes, stackUsed());
+    }
+    lowestFree = min(lowestFree, (uint32_t)ESP.getFreeHeap());
+
+    // Frames run back to back; tell the pattern the time it asked for
+    g_frameDeltaMs = g_frameDelay;
+#ifdef PIXELBOARD_SIM
+    // The simulator's clock only moves when told to
+    simAdvanceMicros((uint64_t)g_frameDelay * 1000);
+#endif
+  }
+
+  endPattern(index);
+  result->heapBytes = (int32_t)(freeBefore - lowestFree);
+  result->leakedBytes = (int32_t)(freeBefore - ESP.getFreeHeap());
+
+  uint64_t total = 0;
+  for (uint16_t f = 0; f < frames; f++) {
+    total += samples[f];
+    uint8_t bucket = 0;
+    while (bucket < BENCH_BUCKETS - 1 && samples[f] >= (8000u << bucket)) {
+      bucket++;
+    }
+    result->histogram[bucket]++;
+  }
+  std::sort(samples, samples + frames);
+  result->meanNs = total / frames;
+  result->p50Ns = samples[frames / 2];
+  result->p99Ns = samples[(frames * 99) / 100];
+  result->maxNs = samples[frames - 1];
+  free(samples);
+  return true;
+}
+
+void benchRun(CRGB* leds, uint16_t frames, uint32_t seed, void (*print)(const char* line)) {
+  char line[160];
+  snprintf(line, sizeof(line), "Render benchmark: %u frames per pattern, seed %u, times in us",
+           frames, (unsigned)seed);
+  print(line);
+  print("pattern              mean     p50     p99     max   heap  leaked  stack");
+
+  for (size_t i = 0; i < PATTERN_COUNT; i++) {
+    BenchResult r;
+    if (!benchPattern(i, leds, frames, seed, &r)) {
+      snprintf(line, sizeof(line), "%-18s failed", g_patternList[i].name);
+      print(line);
+      continue;
+    }
+    snprintf(line, sizeof(line), "%-18s %7.1f %7.1f %7.1f %7.1f %6d %7d %6u",
+             g_patternList[i].name, r.meanNs / 1000.0f, r.p50Ns / 1000.0f, r.p99Ns / 1000.0f,
+             r.maxNs / 1000.0f, (int)r.heapBytes, (int)r.leakedBytes, (unsigned)r.stackBytes);
+    print(line);
+
+    // Histogram, empty buckets left out: "<16us:190" is 190 frames under 16 us
+    int len = snprintf(line, sizeof(line), "  ");
+    for (uint8_t b = 0; b < BENCH_BUCKETS && len < (int)sizeof(line); b++) {
+      if (r.histogram[b] == 0) continue;
+      if (b == BENCH_BUCKETS - 1) {
+        len += snprintf(line + len, sizeof(line) - len, " >=%uus:%u", 8u << (b - 1), r.histogram[b]);
+      } else {
+        len += snprintf(line + len, sizeof(line) - len, " <%uus:%u", 8u << b, r.histogram[b]);
+      }
+    }
+    print(line);
+  }
+}
+
+// --- Float and fixed-point kernels for benchMath()
+
+#define SPARK_COUNT 50
+
+// Keeps the kernels' results alive so the compiler can't drop them
+static volatile int32_t s_sink;
+
+// The arm positions swirl() works out per frame on this display
+static int32_t swirlFloat(uint16_t angle) {
+  float reach = max(LED_WIDTH, LED_HEIGHT) * 0.75f;
+  int32_t sum = 0;
+  for (uint8_t arm = 0; arm < 3; arm++) {
+    for (float radius = 0; radius < reach; radius += 0.25) {
+      float spiralAngle = (angle + 120.0 * arm + radius * 0.7 * 30) * (PI / 180.0);
+      sum += (int)(radius * cos(spiralAngle)) + (int)(radius * sin(spiralAngle));
+    }
+  }
+  return sum;
+}
+
+static int32_t swirlFixed(uint16_t angle) {
+  fix16 reach = fix16FromInt(max(LED_WIDTH, LED_HEIGHT)) * 3 / 4;
+  int32_t sum = 0;
+  for (uint8_t arm = 0; arm < 3; arm++) {
+    uint16_t armAngle = angleFromDegrees(angle + 120 * arm);
+    for (fix16 radius = 0; radius < reach; radius += FIX16_ONE / 4) {
+      uint16_t spiralAngle = armAngle + fix16ToInt(fix16Mul(radius, fix16FromFloat(21 * 65536.0 / 360)));
+      Fix16Vec p = fix16Polar(spiralAngle, radius);
+      sum += fix16ToInt(p.x) + fix16ToInt(p.y);
+    }
+  }
+  return sum;
+}
+
+// Launch and move a full set of sparks, as sparkler() does over a frame
+static int32_t sparksFloat(uint16_t frame) {
+  float x[SPARK_COUNT], y[SPARK_COUNT];
+  int32_t sum = 0;
+  for (uint8_t i = 0; i < SPARK_COUNT; i++) {
+    float angle = (uint8_t)(frame + i * 37) * (TWO_PI / 256.0);
+    float speed = 0.2 + (i * 2 % 100) / 50.0;
+    x[i] = LED_WIDTH / 2 + cos(angle) * speed;
+    y[i] = LED_HEIGHT / 2 + sin(angle) * speed;
+    sum += (int)x[i] + (int)y[i];
+  }
+  return sum;
+}
+
+static int32_t sparksFixed(uint16_t frame) {
+  fix16 x[SPARK_COUNT], y[SPARK_COUNT];
+  int32_t sum = 0;
+  for (uint8_t i = 0; i < SPARK_COUNT; i++) {
+    uint16_t angle = (uint8_t)(frame + i * 37) << 8;
+    fix16 speed = fix16FromFloat(0.2) + (i * 2 % 100) * (FIX16_ONE / 50);
+    x[i] = fix16FromInt(LED_WIDTH / 2) + fix8ToFix16(fix16ToFix8(fix16Mul(fix16Cos(angle), speed)));
+    y[i] = fix16FromInt(LED_HEIGHT / 2) + fix8ToFix16(fix16ToFix8(fix16Mul(fix16Sin(angle), speed)));
+    sum += fix16ToInt(x[i]) + fix16ToInt(y[i]);
+  }
+  return sum;
+}
+
+// Best of `frames` runs, so preemption doesn't count
+static uint32_t bestNs(int32_t (*kernel)(uint16_t), uint16_t frames) {
+  uint32_t best = UINT32_MAX;
+  for (uint16_t f = 0; f < frames; f++) {
+    uint32_t start = ESP.getCycleCount();
+    s_sink = kernel(f * 3);
+    best = min(best, elapsedNs(start));
+  }
+  return best;
+}
+
+void benchMath(uint16_t frames, void (*print)(const char* line)) {
+  char line[160];
+  snprintf(line, sizeof(line), "Float vs fixed-point geometry, best of %u frames on %ux%u, times in us",
+           frames, LED_WIDTH, LED_HEIGHT);
+  print(line);
+
+  uint32_t floatNs = bestNs(swirlFloat, frames), fixedNs = bestNs(swirlFixed, frames);
+  snprintf(line, sizeof(line), "  swirl arms         float %7.1f  fixed %7.1f  (%.1fx)",
+           floatNs / 1000.0f, fixedNs / 1000.0f, (float)floatNs / max(fixedNs, 1u));
+  print(line);
+
+  floatNs = bestNs(sparksFloat, frames);
+  fixedNs = bestNs(sparksFixed, frames);
+  snprintf(line, sizeof(line), "  %u sparks          float %7.1f  fixed %7.1f  (%.1fx)",
+           SPARK_COUNT, floatNs / 1000.0f, fixedNs / 1000.0f, (float)floatNs / max(fixedNs, 1u));
+  print(line);
+}
+
+// --- Tetris AI
+
+static void benchTetrisGame(bool lookahead, uint16_t pieces, uint32_t seed,
+                            void (*print)(const char* line)) {
+  uint32_t* samples = (uint32_t*)malloc(pieces * sizeof(uint32_t));
+  if (!samples) {
+    print("Tetris AI: out of memory");
+    return;
+  }
+  randomSeed(seed);
+  TetrisBoard board = {};
+  uint8_t next = random(TETRIS_PIECES);
+  uint32_t evaluations = 0, placements = 0, lines = 0, games = 1;
+  uint64_t totalNs = 0;
+
+  for (uint16_t i = 0; i < pieces; i++) {
+    TetrisPiece piece = tetrisSpawn(next);
+    next = random(TETRIS_PIECES);
+    if (tetrisCollides(board, piece)) {
+      // Topped out; carry on with a fresh board
+      memset(&board, 0, sizeof(board));
+      games++;
+    }
+
+    TetrisPlan plan;
+    TetrisAIStats stats = {};
+    uint32_t start = ESP.getCycleCount();
+    bool found = tetrisAIPlan(board, piece, lookahead ? next : -1, TETRIS_DEFAULT_WEIGHTS, &plan, &stats);
+    samples[i] = elapsedNs(start);
+    totalNs += samples[i];
+    evaluations += stats.evaluations;
+    placements += stats.placements;
+
+    if (found) {
+      while (tetrisAIAdvance(board, plan, piece)) {}
+      lines += tetrisLock(board, piece);
+    }
+  }
+
+  std::sort(samples, samples + pieces);
+  char line[160];
+  snprintf(line, sizeof(line), "  %-10s %7.1f %7.1f %7.1f %6.1f %7.0f %9.0f %6u %5u",
+           lookahead ? "lookahead" : "greedy", totalNs / 1000.0f / pieces,
+           samples[pieces / 2] / 1000.0f, samples[pieces - 1] / 1000.0f,
+           (float)placements / pieces, (float)evaluations / pieces,
+           totalNs ? evaluations * 1e9f / totalNs : 0.0f, (unsigned)lines, (unsigned)games);
+  print(line);
+  free(samples);
+}
+
+void benchTetris(uint16_t pieces, uint32_t seed, void (*print)(const char* line)) {
+  char line[160];
+  snprintf(line, sizeof(line), "Tetris AI, %u pieces, seed %u, times in us per piece",
+           pieces, (unsigned)seed);
+  print(line);
+  print("  search        mean     p50     max places   evals   evals/s  lines games");
+  benchTetrisGame(false, pieces, seed, print);
+  benchTetrisGame(true, pieces, seed, print);
+}
+
+// --- Preview encoding
+
+void benchPreview(CRGB* leds, uint16_t frames, uint32_t seed, void (*print)(const char* line)) {
+  char line[160];
+  snprintf(line, sizeof(line), "Preview stream: %u frames per pattern, each sent against the one "
+           "before, bytes per frame (raw is %u)", frames, PREVIEW_BYTES);
+  print(line);
+  print("pattern            unchanged  deltas  keyframes  bytes/frame  encode us");
+
+  // Too big for the render task's stack
+  static uint8_t previous[PREVIEW_BYTES], current[PREVIEW_BYTES];
+  static uint8_t runs[PREVIEW_MAX_MESSAGE];
+
+  for (size_t i = 0; i < PATTERN_COUNT; i++) {
+    randomSeed(seed);
+    random16_set_seed(seed);
+    fill_solid(leds, NUM_LEDS, CRGB::Black);
+    memset(previous, 0, sizeof(previous));
+    beginPattern(i);
+    g_frameDeltaMs = 0;
+
+    uint32_t unchanged = 0, deltas = 0, keyframes = 0, bytes = 0;
+    uint64_t encodeNs = 0;
+    for (uint16_t f = 0; f < frames; f++) {
+      setFrameDelay(1);
+      g_patternList[i].func(leds);
+      g_frameDeltaMs = g_frameDelay;
+#ifdef PIXELBOARD_SIM
+      simAdvanceMicros((uint64_t)g_frameDelay * 1000);
+#endif
+
+      // What previewUpdate() (previewSample()) and previewMessage()
+      // (previewEncodeRuns()) do for a client that is one preview behind
+      uint32_t start = ESP.getCycleCount();
+      previewSample(leds, current);
+      size_t len;
+      if (!memcmp(previous, current, PREVIEW_BYTES)) {
+        len = PREVIEW_HEADER;
+        unchanged++;
+      } else {
+        len = previewEncodeRuns(previous, current, runs, PREVIEW_MAX_MESSAGE - PREVIEW_DELTA_HEADER);
+        if (len) {
+          len += PREVIEW_DELTA_HEADER;
+          deltas++;
+        } else {
+          len = PREVIEW_MAX_MESSAGE;
+          keyframes++;
+        }
+        memcpy(previous, current, PREVIEW_BYTES);
+      }
+      encodeNs += elapsedNs(start);
+      bytes += len;
+    }
+    endPattern(i);
+
+    snprintf(line, sizeof(line), "%-18s %9u %7u %10u %12.1f %10.1f", g_patternList[i].name,
+             (unsigned)unchanged, (unsigned)deltas, (unsigned)keyframes, (float)bytes / frames,
+             encodeNs / 1000.0f / frames);
+    print(line);
+  }
+}
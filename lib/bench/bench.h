@@ -0,0 +1,56 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+// Render benchmark for the patterns in g_patternList. Each pattern is
+// switched in, rendered for a number of back-to-back frames from a fixed
+// random seed and switched out again, and the time spent inside its
+// render function is recorded per frame.
+//
+// The same code runs on the device (serial command "bench", executed by
+// the render task) and in the simulator (--bench). Device timings are
+// taken with the CPU cycle counter, host timings with the host clock, so
+// only compare numbers from the same build.
+
+#define BENCH_DEFAULT_FRAMES 200
+#define BENCH_DEFAULT_SEED   1337
+#define BENCH_MAX_FRAMES     2000
+#define BENCH_BUCKETS        12      // power-of-two time buckets, from < 8 us
+#define BENCH_STACK_PAINT    4096    // deepest stack use that can be measured
+
+struct BenchResult {
+  uint16_t frames;
+  uint32_t meanNs, p50Ns, p99Ns, maxNs;
+  int32_t heapBytes;        // most heap held by the pattern while it ran
+  int32_t leakedBytes;      // heap still held after end()
+  uint32_t stackBytes;      // deepest stack used by one frame, 0 if unknown
+  uint16_t histogram[BENCH_BUCKETS];  // bucket b: frames under 8 << b us
+};
+
+// Benchmark one pattern, rendering into `leds`. The caller must own the
+// pattern state, i.e. call this from the render task with no pattern
+// switched in. Returns false if the pattern index or frame count is bad.
+bool benchPattern(size_t index, CRGB* leds, uint16_t frames, uint32_t seed, BenchResult* result);
+
+// Benchmark every pattern and hand the report to `print` line by line
+void benchRun(CRGB* leds, uint16_t frames, uint32_t seed, void (*print)(const char* line));
+
+// Time one frame's worth of swirl() and sparkler() geometry in float, as
+// the patterns did it before lib/fixmath, against the fixed-point version
+// they use now, and report the best of `frames` runs of each
+void benchMath(uint16_t frames, void (*print)(const char* line));
+
+// Let the Tetris AI play `pieces` pieces of a seeded game, with and
+// without its one-piece lookahead, and report the time per decision and
+// the boards it scores per second
+void benchTetris(uint16_t pieces, uint32_t seed, void (*print)(const char* line));
+
+// Render every pattern as benchRun() does and encode each frame for the
+// web preview (lib/preview) against the frame before it, as it streams to
+// a page that keeps up. Reports how many frames went out as "unchanged",
+// as changed-pixel runs or as keyframes, and the bytes per frame.
+void benchPreview(CRGB* leds, uint16_t frames, uint32_t seed, void (*print)(const char* line));
+
+#endif // BENCH_H
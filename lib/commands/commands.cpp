@@ -0,0 +1,63 @@
+#include "commands.h"
+#include <atomic>
+#include <patterns.h>
+
+static Command s_ring[COMMAND_QUEUE_SIZE];
+static std::atomic<uint32_t> s_head(0);   // next slot to write, owned by the producer
+static std::atomic<uint32_t> s_tail(0);   // next slot to read, owned by the consumer
+
+static bool push(const Command& cmd) {
+    uint32_t head = s_head.load(std::memory_order_relaxed);
+    uint32_t tail = s_tail.load(std::memory_order_acquire);
+    if (head - tail >= COMMAND_QUEUE_SIZE) {
+        return false;
+    }
+
+    s_ring[head & (COMMAND_QUEUE_SIZE - 1)] = cmd;
+    s_head.store(head + 1, std::memory_order_release);
+
+    // Wake the renderer so the command lands on the next frame
+    requestFrame();
+    return true;
+}
+
+bool commandPost(CommandType type, int32_t value, const char* arg) {
+    Command cmd = {};
+    cmd.type = type;
+    cmd.value = value;
+    if (arg) {
+        strlcpy(cmd.arg, arg, sizeof(cmd.arg));
+    }
+    return push(cmd);
+}
+
+bool commandPostText(CommandType type, const char* text, int32_t value, int32_t value2, const char* arg) {
+    Command cmd = {};
+    cmd.type = type;
+    cmd.value = value;
+    cmd.value2 = value2;
+    if (arg) {
+        strlcpy(cmd.arg, arg, sizeof(cmd.arg));
+    }
+    cmd.text = strdup(text);
+    if (!cmd.text) {
+        return false;
+    }
+    if (!push(cmd)) {
+        free(cmd.text);
+        return false;
+    }
+    return true;
+}
+
+bool commandTake(Command* cmd) {
+    uint32_t tail = s_tail.load(std::memory_order_relaxed);
+    uint32_t head = s_head.load(std::memory_order_acquire);
+    if (tail == head) {
+        return false;
+    }
+
+    *cmd = s_ring[tail & (COMMAND_QUEUE_SIZE - 1)];
+    s_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
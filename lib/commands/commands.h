@@ -0,0 +1,47 @@
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include <Arduino.h>
+
+// Control messages from the web handlers to the renderer.
+//
+// Handlers run in the AsyncTCP task and must not touch renderer state
+// (the current pattern, game state, the scrolling text String...) directly.
+// Instead they post a Command, and the render task applies every queued
+// command at the start of its next frame. The queue is a single-producer /
+// single-consumer ring: the AsyncTCP task is the only producer and the
+// render task the only consumer, so no locks are needed.
+
+#define COMMAND_QUEUE_SIZE 32   // must be a power of two
+
+enum CommandType : uint8_t {
+    CMD_SET_PATTERN,        // value = pattern index
+    CMD_SET_BRIGHTNESS,     // value = 0..255
+    CMD_SET_SPEED,          // value = 0..255
+    CMD_SNAKE_DIRECTION,    // arg = "up" / "down" / "left" / "right"
+    CMD_SNAKE_ACTION,       // arg = "start" / "restart" / "aiOn" / "aiOff"
+    CMD_TETRIS_ACTION,      // arg = game action, e.g. "rotate"
+    CMD_CLOCK_ACTION,       // arg = "start" / "pause" / "reset", value = seconds or -1
+    CMD_SET_TEXT,           // text = new text, value/value2 = text/background RGB, arg = font
+    CMD_SET_ANIMATION,      // text = sheet name in /sprites, without ".pxs"
+    CMD_INSTALL_ANIMATION   // text = sheet name, to be replaced by the finished upload
+};
+
+struct Command {
+    CommandType type;
+    int32_t value;
+    int32_t value2;
+    char arg[12];           // short verb, always NUL terminated
+    char* text;             // optional malloc'd payload, freed once applied
+};
+
+// Producer side (AsyncTCP task). Returns false if the queue is full, in
+// which case any text payload is freed and the caller should answer 503.
+bool commandPost(CommandType type, int32_t value = 0, const char* arg = nullptr);
+bool commandPostText(CommandType type, const char* text, int32_t value = 0,
+                     int32_t value2 = 0, const char* arg = nullptr);
+
+// Consumer side (render task). Returns false once the queue is empty.
+bool commandTake(Command* cmd);
+
+#endif // COMMANDS_H
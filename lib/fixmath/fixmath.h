@@ -0,0 +1,78 @@
+#ifndef FIXMATH_H
+#define FIXMATH_H
+
+#include <FastLED.h>
+
+// Fixed-point maths for pattern geometry. The ESP32's FPU only does single
+// precision, and cos()/sin() on a float promote to double, which is done in
+// software; these keep per-pixel maths in integer registers instead.
+//
+//   fix16  Q16.16 in an int32_t: positions, radii, velocities. Covers
+//          +-32767 with 1/65536 resolution, plenty for any display.
+//   fix8   Q8.8 in an int16_t: small quantities (+-127) where storage
+//          matters, e.g. per-particle velocities.
+//
+// Angles are FastLED's: a uint16_t with 65536 to the full turn, the unit
+// of sin16()/cos16() and of LedPolar::angle, so they wrap for free.
+// Conversions to int round toward minus infinity, unlike a float cast.
+
+typedef int32_t fix16;
+typedef int16_t fix8;
+
+#define FIX16_ONE 65536
+#define FIX8_ONE  256
+
+// Compile-time constants only; at run time this would be float maths again
+constexpr fix16 fix16FromFloat(double v) { return (fix16)(v * FIX16_ONE + (v < 0 ? -0.5 : 0.5)); }
+constexpr fix8 fix8FromFloat(double v) { return (fix8)(v * FIX8_ONE + (v < 0 ? -0.5 : 0.5)); }
+
+static inline fix16 fix16FromInt(int32_t v) { return v * FIX16_ONE; }
+static inline int32_t fix16ToInt(fix16 v) { return v >> 16; }
+static inline int32_t fix16Round(fix16 v) { return (v + FIX16_ONE / 2) >> 16; }
+
+static inline fix16 fix16Mul(fix16 a, fix16 b) { return (fix16)(((int64_t)a * b) >> 16); }
+static inline fix16 fix16Div(fix16 a, fix16 b) { return (fix16)(((int64_t)a << 16) / b); }
+
+// a + (b - a) * t, t in 0..FIX16_ONE
+static inline fix16 fix16Lerp(fix16 a, fix16 b, fix16 t) { return a + fix16Mul(b - a, t); }
+
+static inline fix8 fix8FromInt(int16_t v) { return v * FIX8_ONE; }
+static inline int16_t fix8ToInt(fix8 v) { return v >> 8; }
+static inline fix8 fix8Mul(fix8 a, fix8 b) { return (fix8)(((int32_t)a * b) >> 8); }
+
+static inline fix16 fix8ToFix16(fix8 v) { return (fix16)v * (FIX16_ONE / FIX8_ONE); }
+static inline fix8 fix16ToFix8(fix16 v) { return (fix8)(v >> 8); }
+
+// Angle of `degrees`, any non-negative value
+static inline uint16_t angleFromDegrees(uint32_t degrees) {
+  return (uint16_t)((degrees % 360) * 65536 / 360);
+}
+
+// sin16() is Q1.15, one bit short of fix16; the largest value is 0.99997
+static inline fix16 fix16Sin(uint16_t angle) { return (fix16)sin16(angle) * 2; }
+static inline fix16 fix16Cos(uint16_t angle) { return (fix16)cos16(angle) * 2; }
+
+struct Fix16Vec {
+  fix16 x;
+  fix16 y;
+
+  Fix16Vec& operator+=(const Fix16Vec& v) { x += v.x; y += v.y; return *this; }
+  Fix16Vec& operator-=(const Fix16Vec& v) { x -= v.x; y -= v.y; return *this; }
+  Fix16Vec operator+(const Fix16Vec& v) const { return {x + v.x, y + v.y}; }
+  Fix16Vec operator-(const Fix16Vec& v) const { return {x - v.x, y - v.y}; }
+};
+
+static inline Fix16Vec fix16VecFromInt(int32_t x, int32_t y) {
+  return {fix16FromInt(x), fix16FromInt(y)};
+}
+
+static inline Fix16Vec fix16VecScale(const Fix16Vec& v, fix16 s) {
+  return {fix16Mul(v.x, s), fix16Mul(v.y, s)};
+}
+
+// The point `radius` away from the origin in direction `angle`
+static inline Fix16Vec fix16Polar(uint16_t angle, fix16 radius) {
+  return {fix16Mul(fix16Cos(angle), radius), fix16Mul(fix16Sin(angle), radius)};
+}
+
+#endif // FIXMATH_H
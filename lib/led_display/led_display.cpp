@@ -1,23 +1,260 @@
 #include "led_display.h"
+#include <Preferences.h>
 
+LedGeometry g_geometry = {
+  LED_PANEL_WIDTH, LED_PANEL_HEIGHT, LED_TILES_X, LED_TILES_Y,
+  LED_WIRING, LED_ROTATION, LED_MIRROR, LED_SERPENTINE_TILES
+};
+uint16_t g_ledWidth, g_ledHeight, g_numLeds;
+uint16_t g_xyTable[LED_MAX_LEDS];
+LedPolar g_polarTable[LED_MAX_LEDS];
 
-void led_setup(CRGB* leds, int DATA_PIN, int LED_COUNT){
-    // tell FastLED about the LED strip configuration
-  FastLED.setBrightness(200);
+// Front buffer: the most recent finished frame, swapped in by led_present()
+static CRGB s_front[LED_MAX_LEDS];
+static uint8_t s_frontBrightness = 0;
+static portMUX_TYPE s_frontLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Strip buffer registered with FastLED, only touched by the output task
+static CRGB s_strip[LED_MAX_LEDS];
+static TaskHandle_t s_outputTask = nullptr;
+
+// Written by the output task only; readers may see a slightly stale value
+static uint8_t s_outputs = 0;
+static uint16_t s_ledsPerOutput = 0;
+static volatile uint32_t s_lastShowUs = 0;
+static volatile uint32_t s_averageShowUs = 0;
+static volatile uint32_t s_shownFrames = 0;
+static volatile uint32_t s_presentedFrames = 0;   // written by the renderer
+
+// Wait for a new front buffer, take a private copy of it and clock it out.
+// The copy keeps the lock short; show() blocks on the RMT transfer without
+// holding it, so the renderer can present the next frame meanwhile.
+static void outputTask(void* param) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    portENTER_CRITICAL(&s_frontLock);
+    memcpy(s_strip, s_front, NUM_LEDS * sizeof(CRGB));
+    uint8_t brightness = s_frontBrightness;
+    portEXIT_CRITICAL(&s_frontLock);
+
+    FastLED.setBrightness(brightness);
+    uint32_t start = micros();
+    FastLED.show();
+    uint32_t elapsed = micros() - start;
+
+    s_lastShowUs = elapsed;
+    s_averageShowUs = s_shownFrames ? s_averageShowUs + ((int32_t)(elapsed - s_averageShowUs) >> 4) : elapsed;
+    s_shownFrames = s_shownFrames + 1;
+  }
 }
 
-void setBrightness(int brightness){
-  FastLED.setBrightness(brightness);
+// Register one run of the strip on output `index` (0-based). FastLED needs
+// the pin as a template argument, hence the switch.
+static void addOutput(uint8_t index, CRGB* leds, uint16_t count) {
+  switch (index) {
+    case 0: FastLED.addLeds<LED_TYPE, LED_DATA_PIN, COLOR_ORDER>(leds, count).setCorrection(TypicalLEDStrip); break;
+#if LED_OUTPUTS >= 2
+    case 1: FastLED.addLeds<LED_TYPE, LED_DATA_PIN_2, COLOR_ORDER>(leds, count).setCorrection(TypicalLEDStrip); break;
+#endif
+#if LED_OUTPUTS >= 3
+    case 2: FastLED.addLeds<LED_TYPE, LED_DATA_PIN_3, COLOR_ORDER>(leds, count).setCorrection(TypicalLEDStrip); break;
+#endif
+#if LED_OUTPUTS >= 4
+    case 3: FastLED.addLeds<LED_TYPE, LED_DATA_PIN_4, COLOR_ORDER>(leds, count).setCorrection(TypicalLEDStrip); break;
+#endif
+#if LED_OUTPUTS >= 5
+    case 4: FastLED.addLeds<LED_TYPE, LED_DATA_PIN_5, COLOR_ORDER>(leds, count).setCorrection(TypicalLEDStrip); break;
+#endif
+#if LED_OUTPUTS >= 6
+    case 5: FastLED.addLeds<LED_TYPE, LED_DATA_PIN_6, COLOR_ORDER>(leds, count).setCorrection(TypicalLEDStrip); break;
+#endif
+#if LED_OUTPUTS >= 7
+    case 6: FastLED.addLeds<LED_TYPE, LED_DATA_PIN_7, COLOR_ORDER>(leds, count).setCorrection(TypicalLEDStrip); break;
+#endif
+#if LED_OUTPUTS >= 8
+    case 7: FastLED.addLeds<LED_TYPE, LED_DATA_PIN_8, COLOR_ORDER>(leds, count).setCorrection(TypicalLEDStrip); break;
+#endif
+  }
+}
+
+#if LED_OUTPUTS < 1 || LED_OUTPUTS > 8
+#error "LED_OUTPUTS must be between 1 and 8"
+#endif
+
+// Split the panel chain into runs of whole panels, one per output. Panel
+// k starts at LED k * panelLeds, so each run is a contiguous slice.
+static void setupOutputs() {
+  uint16_t panels = g_geometry.tilesX * g_geometry.tilesY;
+  uint16_t panelLeds = g_geometry.panelWidth * g_geometry.panelHeight;
+  uint8_t outputs = min<uint16_t>(LED_OUTPUTS, panels);
+  uint16_t panelsPerOutput = (panels + outputs - 1) / outputs;
+
+  uint16_t first = 0;
+  s_outputs = 0;
+  for (uint8_t i = 0; i < outputs && first < panels; i++) {
+    uint16_t count = min<uint16_t>(panelsPerOutput, panels - first);
+    addOutput(i, s_strip + first * panelLeds, count * panelLeds);
+    first += count;
+    s_outputs++;
+  }
+  s_ledsPerOutput = panelsPerOutput * panelLeds;
+  Serial.printf("LED output: %u data pin(s), up to %u LEDs each\n", s_outputs, s_ledsPerOutput);
 }
 
-void loadArray(const long arr[], CRGB* leds, const long Color /*= 0*/, const long replacementColor /*= 0*/) {
-  for(int i = 0; i < NUM_LEDS; i++) {
-    long color = pgm_read_dword(&(arr[i]));  // Read array from Flash
-    if (color == Color) {
-        leds[i] = replacementColor;
-    } else {
-        leds[i] = color;
+bool led_valid_geometry(const LedGeometry& g) {
+  if (g.panelWidth == 0 || g.panelHeight == 0 || g.tilesX == 0 || g.tilesY == 0) {
+    return false;
+  }
+  if (g.wiring > LED_WIRING_PROGRESSIVE || g.rotation > 3) {
+    return false;
+  }
+  // Quarter turns swap a panel's rows and columns
+  if (g.rotation % 2 == 1 && g.panelWidth != g.panelHeight) {
+    return false;
+  }
+  return (uint32_t)g.panelWidth * g.tilesX * g.panelHeight * g.tilesY <= LED_MAX_LEDS;
+}
+
+static void loadGeometry() {
+  Preferences prefs;
+  prefs.begin("display", true);
+  LedGeometry g;
+  g.panelWidth = prefs.getUChar("panelW", g_geometry.panelWidth);
+  g.panelHeight = prefs.getUChar("panelH", g_geometry.panelHeight);
+  g.tilesX = prefs.getUChar("tilesX", g_geometry.tilesX);
+  g.tilesY = prefs.getUChar("tilesY", g_geometry.tilesY);
+  g.wiring = prefs.getUChar("wiring", g_geometry.wiring);
+  g.rotation = prefs.getUChar("rotation", g_geometry.rotation);
+  g.mirror = prefs.getBool("mirror", g_geometry.mirror);
+  g.serpentineTiles = prefs.getBool("serpTiles", g_geometry.serpentineTiles);
+  prefs.end();
+
+  if (led_valid_geometry(g)) {
+    g_geometry = g;
+  } else {
+    Serial.println("Stored display geometry is invalid, using the default");
+  }
+
+  g_ledWidth = g_geometry.width();
+  g_ledHeight = g_geometry.height();
+  g_numLeds = g_geometry.numLeds();
+  for (uint16_t y = 0; y < g_ledHeight; y++) {
+    for (uint16_t x = 0; x < g_ledWidth; x++) {
+      g_xyTable[y * g_ledWidth + x] = ledIndex(g_geometry, x, y);
+
+      float dx = (int)x - g_ledWidth / 2;
+      float dy = (int)y - g_ledHeight / 2;
+      float turns = atan2f(dy, dx) / (2 * PI);
+      LedPolar& p = g_polarTable[y * g_ledWidth + x];
+      p.angle = (uint16_t)(int32_t)lroundf((turns < 0 ? turns + 1 : turns) * 65536);
+      p.radius = lroundf(sqrtf(dx * dx + dy * dy) * LED_POLAR_UNIT);
     }
   }
+  Serial.printf("Display: %ux%u (%ux%u panels of %ux%u), %u LEDs\n",
+                g_ledWidth, g_ledHeight, g_geometry.tilesX, g_geometry.tilesY,
+                g_geometry.panelWidth, g_geometry.panelHeight, g_numLeds);
+}
+
+bool led_save_geometry(const LedGeometry& g) {
+  if (!led_valid_geometry(g)) {
+    return false;
+  }
+  Preferences prefs;
+  prefs.begin("display", false);
+  prefs.putUChar("panelW", g.panelWidth);
+  prefs.putUChar("panelH", g.panelHeight);
+  prefs.putUChar("tilesX", g.tilesX);
+  prefs.putUChar("tilesY", g.tilesY);
+  prefs.putUChar("wiring", g.wiring);
+  prefs.putUChar("rotation", g.rotation);
+  prefs.putBool("mirror", g.mirror);
+  prefs.putBool("serpTiles", g.serpentineTiles);
+  prefs.end();
+  return true;
+}
+
+void led_setup() {
+  loadGeometry();
+
+  // tell FastLED about the LED strip configuration
+  setupOutputs();
+
+  // Start with display off
+  FastLED.setBrightness(0);
   FastLED.show();
+
+  // The RMT peripheral does the bit timing and its interrupt is installed
+  // on the core that first calls show(), so keep that off the WiFi core
+  xTaskCreatePinnedToCore(outputTask, "ledOutput", 4096, nullptr,
+                          LED_OUTPUT_PRIORITY, &s_outputTask, LED_OUTPUT_CORE);
+}
+
+void led_present(const CRGB* frame, uint8_t brightness) {
+  portENTER_CRITICAL(&s_frontLock);
+  memcpy(s_front, frame, NUM_LEDS * sizeof(CRGB));
+  s_frontBrightness = brightness;
+  s_presentedFrames = s_presentedFrames + 1;
+  portEXIT_CRITICAL(&s_frontLock);
+
+  // If the task is still busy with the previous frame, the notification is
+  // latched and it picks up this (newer) front buffer when it loops around
+  if (s_outputTask) {
+    xTaskNotifyGive(s_outputTask);
+  }
+}
+
+uint32_t led_snapshot(CRGB* dest) {
+  portENTER_CRITICAL(&s_frontLock);
+  memcpy(dest, s_front, NUM_LEDS * sizeof(CRGB));
+  uint32_t frame = s_presentedFrames;
+  portEXIT_CRITICAL(&s_frontLock);
+  return frame;
+}
+
+uint32_t led_frame_number() {
+  return s_presentedFrames;
+}
+
+void led_output_stats(LedOutputStats* stats) {
+  stats->outputs = s_outputs;
+  stats->ledsPerOutput = s_ledsPerOutput;
+  stats->lastShowUs = s_lastShowUs;
+  stats->averageShowUs = s_averageShowUs;
+  stats->frames = s_shownFrames;
+  stats->presented = s_presentedFrames;
+}
+
+// The arithmetic serpentine mapping XY() used before the lookup table,
+// kept only as the baseline for led_benchmark_mapping()
+#define XY_ARITHMETIC(x, y) ((y) % 2 == 0 ? ((y) * LED_WIDTH + (LED_WIDTH - 1 - (x))) : ((y) * LED_WIDTH + (x)))
+
+#define MAPPING_BENCH_FRAMES 200
+
+// Fill a frame the way the patterns do, once per mapping, and report the
+// cheapest frame of each so preemption by the render task doesn't count
+void led_benchmark_mapping() {
+  static CRGB frame[LED_MAX_LEDS];
+  uint32_t bestArithmetic = UINT32_MAX, bestTable = UINT32_MAX;
+
+  for (int f = 0; f < MAPPING_BENCH_FRAMES; f++) {
+    uint32_t start = ESP.getCycleCount();
+    for (uint16_t y = 0; y < LED_HEIGHT; y++) {
+      for (uint16_t x = 0; x < LED_WIDTH; x++) {
+        frame[XY_ARITHMETIC(x, y)] = CRGB(x, y, f);
+      }
+    }
+    bestArithmetic = min(bestArithmetic, ESP.getCycleCount() - start);
+
+    start = ESP.getCycleCount();
+    for (uint16_t y = 0; y < LED_HEIGHT; y++) {
+      for (uint16_t x = 0; x < LED_WIDTH; x++) {
+        frame[XY(x, y)] = CRGB(x, y, f);
+      }
+    }
+    bestTable = min(bestTable, ESP.getCycleCount() - start);
+  }
+
+  Serial.printf("XY mapping, CPU cycles per %ux%u frame: arithmetic %u, table %u\n",
+                LED_WIDTH, LED_HEIGHT, (unsigned)bestArithmetic, (unsigned)bestTable);
 }
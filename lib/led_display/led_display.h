@@ -1,20 +1,143 @@
 #ifndef LED_DISPLAY_H
 #define LED_DISPLAY_H
-#define NUM_LEDS    256
 #define LED_TYPE    WS2811
 #define COLOR_ORDER GRB
+#define LED_DATA_PIN    26
+#define LED_OUTPUT_CORE     1   // same core as the renderer, away from WiFi
+#define LED_OUTPUT_PRIORITY 4   // above the render task so frames go out at once
 extern int BRIGHTNESS;
 
-// XY mapping for 16x16 matrix with alternating row directions
-#define XY(x, y) ((y) % 2 == 0 ?  ((y) * 16 + (15 - (x))) : ((y) * 16 + (x)) )
+// Frame buffers are sized at build time for the largest display the board
+// will drive; the actual geometry is loaded from preferences at boot.
+#ifndef LED_MAX_LEDS
+#define LED_MAX_LEDS 1024
+#endif
+
+// Default geometry, a single 16x16 serpentine panel. Override with -D in
+// platformio.ini, or at runtime through /geometry.
+#ifndef LED_PANEL_WIDTH
+#define LED_PANEL_WIDTH  16
+#endif
+#ifndef LED_PANEL_HEIGHT
+#define LED_PANEL_HEIGHT 16
+#endif
+#ifndef LED_TILES_X
+#define LED_TILES_X 1
+#endif
+#ifndef LED_TILES_Y
+#define LED_TILES_Y 1
+#endif
+#ifndef LED_WIRING
+#define LED_WIRING  LED_WIRING_SERPENTINE
+#endif
+#ifndef LED_ROTATION
+#define LED_ROTATION 0             // quarter turns clockwise
+#endif
+#ifndef LED_MIRROR
+#define LED_MIRROR 0               // flip left/right
+#endif
+#ifndef LED_SERPENTINE_TILES
+#define LED_SERPENTINE_TILES 0
+#endif
+
+// Parallel outputs for large displays. The panel chain is split into
+// LED_OUTPUTS runs of whole panels, output 1 on LED_DATA_PIN and the others
+// on LED_DATA_PIN_2.., and FastLED clocks all of them out at once (one RMT
+// channel each, up to 8; build with -D FASTLED_ESP32_I2S=true to use the
+// I2S driver instead). A frame then takes as long as the longest run, not
+// the whole chain.
+#ifndef LED_OUTPUTS
+#define LED_OUTPUTS 1
+#endif
+#ifndef LED_DATA_PIN_2
+#define LED_DATA_PIN_2  25
+#endif
+#ifndef LED_DATA_PIN_3
+#define LED_DATA_PIN_3  33
+#endif
+#ifndef LED_DATA_PIN_4
+#define LED_DATA_PIN_4  32
+#endif
+#ifndef LED_DATA_PIN_5
+#define LED_DATA_PIN_5  27
+#endif
+#ifndef LED_DATA_PIN_6
+#define LED_DATA_PIN_6  14
+#endif
+#ifndef LED_DATA_PIN_7
+#define LED_DATA_PIN_7  12
+#endif
+#ifndef LED_DATA_PIN_8
+#define LED_DATA_PIN_8  13
+#endif
 
 #include <FastLED.h>
+#include "led_map.h"
 
-void setBrightness(int brightness);
-void led_setup(CRGB* leds, int DATA_PIN, int LED_COUNT);
-void loadArray(const long arr[], CRGB* leds, const long Color = 0 , const long replacementColor = 0);
+// Current display geometry. Patterns size themselves from these and must
+// not assume 16x16; use LED_MAX_LEDS for static buffers.
+extern LedGeometry g_geometry;
+extern uint16_t g_ledWidth, g_ledHeight, g_numLeds;
+extern uint16_t g_xyTable[LED_MAX_LEDS];
 
-#endif // LED_DISPLAY_H
+#define LED_WIDTH   g_ledWidth
+#define LED_HEIGHT  g_ledHeight
+#define NUM_LEDS    g_numLeds
+
+// LED index of display pixel (x, y); both must be on the display
+static inline uint16_t XY(uint16_t x, uint16_t y) {
+  return g_xyTable[y * g_ledWidth + x];
+}
+
+// Polar coordinates of every display pixel around the center pixel
+// (LED_WIDTH / 2, LED_HEIGHT / 2), worked out once by led_setup() so
+// radial patterns can look them up instead of calling atan2f() and
+// sqrt() per pixel. Angles run clockwise from 3 o'clock, 65536 to the
+// full turn like FastLED's sin16(); radii are in 1/16 pixel.
+#define LED_POLAR_UNIT 16
+struct LedPolar {
+  uint16_t angle;
+  uint16_t radius;
+};
+extern LedPolar g_polarTable[LED_MAX_LEDS];
 
+static inline const LedPolar& polarAt(uint16_t x, uint16_t y) {
+  return g_polarTable[y * g_ledWidth + x];
+}
 
+// Geometry is read from preferences by led_setup(). led_save_geometry()
+// validates and stores a new one, which takes effect on the next boot.
+bool led_valid_geometry(const LedGeometry& geometry);
+bool led_save_geometry(const LedGeometry& geometry);
 
+// Double-buffered output: patterns render into their own back buffer and
+// hand finished frames to led_present(), which swaps them into the front
+// buffer. A dedicated output task transmits the front buffer, so the next
+// frame renders while the strip is being clocked out and nobody else ever
+// calls FastLED.show().
+void led_setup();
+void led_present(const CRGB* frame, uint8_t brightness);
+// Frames are numbered as they are presented. led_snapshot() copies the
+// last one and returns its number, so a reader can tell whether anything
+// new has been drawn since it last looked.
+uint32_t led_snapshot(CRGB* dest);
+uint32_t led_frame_number();
+
+// Output timing: how many data pins are in use, and how long show() took
+// for the last frame and on average (exponential, over ~16 frames).
+// Frames presented while the output task was still busy are replaced by
+// the next one, so presented - frames is the number of dropped frames.
+struct LedOutputStats {
+  uint8_t outputs;
+  uint16_t ledsPerOutput;      // longest run
+  uint32_t lastShowUs;
+  uint32_t averageShowUs;
+  uint32_t frames;             // shown
+  uint32_t presented;          // handed to led_present()
+};
+void led_output_stats(LedOutputStats* stats);
+
+// Time XY() against the old arithmetic mapping and print the result
+void led_benchmark_mapping();
+
+#endif // LED_DISPLAY_H
@@ -0,0 +1,63 @@
+#ifndef LED_MAP_H
+#define LED_MAP_H
+
+#include <stdint.h>
+
+// (x, y) -> LED index mapping for tiled displays.
+//
+// Patterns address the display as x = 0..width-1 left to right and
+// y = 0..height-1 top to bottom. The display is a grid of identical panels
+// chained on one data line; how a pixel lands on the strip depends on how
+// each panel is wired and mounted and on the order the panels are chained
+// in. led_display builds a table from this once at boot, so XY() itself is
+// a single load.
+
+#define LED_WIRING_SERPENTINE   0   // rows alternate direction, row 0 runs right to left
+#define LED_WIRING_PROGRESSIVE  1   // every row runs left to right
+
+struct LedGeometry {
+  uint8_t panelWidth;      // LEDs per panel row
+  uint8_t panelHeight;     // LED rows per panel
+  uint8_t tilesX;          // panels across
+  uint8_t tilesY;          // panels down
+  uint8_t wiring;          // LED_WIRING_* inside each panel
+  uint8_t rotation;        // quarter turns clockwise each panel is mounted at
+  bool mirror;             // panels mounted flipped left/right
+  bool serpentineTiles;    // the panel chain reverses on every other panel row
+
+  constexpr uint16_t width() const { return panelWidth * tilesX; }
+  constexpr uint16_t height() const { return panelHeight * tilesY; }
+  constexpr uint16_t numLeds() const { return width() * height(); }
+};
+
+// Index within one panel of panel pixel (x, y): mirror, then rotate
+// clockwise by `rotation` quarter turns, then follow the strip along the rows
+constexpr uint16_t ledPanelIndex(const LedGeometry& g, uint8_t x, uint8_t y) {
+  uint8_t w = g.panelWidth, h = g.panelHeight;
+  if (g.mirror) {
+    x = w - 1 - x;
+  }
+  uint8_t px = x, py = y;
+  switch (g.rotation) {
+    case 1: px = w - 1 - y; py = x;         break;
+    case 2: px = w - 1 - x; py = h - 1 - y; break;
+    case 3: px = y;         py = h - 1 - x; break;
+  }
+  if (g.wiring == LED_WIRING_SERPENTINE && py % 2 == 0) {
+    px = w - 1 - px;
+  }
+  return py * w + px;
+}
+
+// LED index of display pixel (x, y)
+constexpr uint16_t ledIndex(const LedGeometry& g, uint16_t x, uint16_t y) {
+  uint8_t tx = x / g.panelWidth, ty = y / g.panelHeight;
+  if (g.serpentineTiles && ty % 2 == 1) {
+    tx = g.tilesX - 1 - tx;
+  }
+  uint16_t panel = ty * g.tilesX + tx;
+  return panel * g.panelWidth * g.panelHeight +
+         ledPanelIndex(g, x % g.panelWidth, y % g.panelHeight);
+}
+
+#endif // LED_MAP_H
@@ -0,0 +1,67 @@
+#include "metrics.h"
+#include <led_display.h>
+
+static FrameMetrics s_ring[METRICS_FRAMES];
+static uint32_t s_count = 0;     // frames recorded since boot
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void metricsRecord(const FrameMetrics& frame) {
+  portENTER_CRITICAL(&s_lock);
+  s_ring[s_count % METRICS_FRAMES] = frame;
+  s_count++;
+  portEXIT_CRITICAL(&s_lock);
+}
+
+size_t metricsSnapshot(FrameMetrics* frames, size_t max) {
+  portENTER_CRITICAL(&s_lock);
+  size_t n = min<uint32_t>(min<uint32_t>(s_count, METRICS_FRAMES), max);
+  uint32_t first = s_count - n;
+  for (size_t i = 0; i < n; i++) {
+    frames[i] = s_ring[(first + i) % METRICS_FRAMES];
+  }
+  portEXIT_CRITICAL(&s_lock);
+  return n;
+}
+
+void metricsSummarize(MetricsSummary* s) {
+  memset(s, 0, sizeof(*s));
+  // Too big for the stack of the tasks that ask
+  FrameMetrics* frames = (FrameMetrics*)malloc(METRICS_FRAMES * sizeof(FrameMetrics));
+  if (!frames) {
+    return;
+  }
+  size_t n = metricsSnapshot(frames, METRICS_FRAMES);
+
+  uint64_t render = 0, show = 0, late = 0, idle = 0;
+  for (size_t i = 0; i < n; i++) {
+    const FrameMetrics& f = frames[i];
+    render += f.renderUs;
+    show += f.showUs;
+    late += f.lateUs;
+    idle += f.idleUs;
+    s->renderMaxUs = max(s->renderMaxUs, f.renderUs);
+    s->showMaxUs = max(s->showMaxUs, f.showUs);
+    s->lateMaxUs = max(s->lateMaxUs, f.lateUs);
+    if (f.lateUs > METRICS_LATE_US) {
+      s->lateFrames++;
+    }
+  }
+  if (n > 0) {
+    s->frames = n;
+    s->renderMeanUs = render / n;
+    s->showMeanUs = show / n;
+    s->lateMeanUs = late / n;
+    s->idleMeanUs = idle / n;
+  }
+  if (n > 1) {
+    uint32_t span = frames[n - 1].startUs - frames[0].startUs;
+    s->fps = span ? (n - 1) * 1000000.0f / span : 0;
+  }
+  free(frames);
+
+  // One frame may legitimately be in flight on the output task
+  LedOutputStats stats;
+  led_output_stats(&stats);
+  s->presented = stats.presented;
+  s->dropped = stats.presented > stats.frames + 1 ? stats.presented - stats.frames - 1 : 0;
+}
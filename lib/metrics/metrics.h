@@ -0,0 +1,41 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+
+// Frame timing for the render loop. The render task records one entry per
+// frame it draws into a ring of the last METRICS_FRAMES frames; the web
+// server (/metrics) and the serial console ("metrics") read it.
+
+#define METRICS_FRAMES 128
+#define METRICS_LATE_US 2000    // later than this counts as a late frame
+
+struct FrameMetrics {
+  uint32_t startUs;     // micros() when the frame started
+  uint32_t periodUs;    // delay the previous frame asked for
+  uint32_t lateUs;      // how long after its due time the frame started
+  uint32_t idleUs;      // since the previous frame was presented
+  uint32_t renderUs;    // pattern switch, pattern and present
+  uint32_t showUs;      // most recent show() on the output task
+};
+
+struct MetricsSummary {
+  uint16_t frames;                // entries in the ring
+  float fps;                      // over the span of the ring
+  uint32_t renderMeanUs, renderMaxUs;
+  uint32_t showMeanUs, showMaxUs;
+  uint32_t lateMeanUs, lateMaxUs;  // scheduling jitter
+  uint32_t idleMeanUs;
+  uint16_t lateFrames;            // started over METRICS_LATE_US late
+  uint32_t presented;             // frames handed to the output task
+  uint32_t dropped;               // ...replaced by a newer one before being shown
+};
+
+// Render task only
+void metricsRecord(const FrameMetrics& frame);
+
+// Any task. Copies out up to `max` entries, oldest first.
+size_t metricsSnapshot(FrameMetrics* frames, size_t max);
+void metricsSummarize(MetricsSummary* summary);
+
+#endif // METRICS_H
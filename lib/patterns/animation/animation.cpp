@@ -0,0 +1,208 @@
+#include "animation.h"
+#include <led_display.h>
+#include <patterns.h>
+#include <commands.h>
+#include <sprites.h>
+#include "SPIFFS.h"
+#include <webassets.h>
+#include <atomic>
+
+#define SPRITE_DIR        "/sprites/"
+#define UPLOAD_TEMP_PATH  "/sprites/upload.tmp"
+// SPIFFS paths are at most 31 characters: "/sprites/" + name + ".pxs"
+#define MAX_NAME_LENGTH   18
+
+static SpriteStream s_stream;
+static char s_name[MAX_NAME_LENGTH + 1] = "waterSheet";
+static bool s_active = false;
+
+// One upload at a time, as they all go through UPLOAD_TEMP_PATH. Set by
+// the AsyncTCP task when an upload starts, and cleared once its temporary
+// file is gone: by the AsyncTCP task if the upload fails, or by the
+// render task once animationInstall() has moved it into place.
+static std::atomic<bool> s_uploadBusy(false);
+
+// Upload state, only touched by the AsyncTCP task. s_uploadRequest is the
+// request that owns the upload until it has been answered.
+static AsyncWebServerRequest* s_uploadRequest = nullptr;
+static File s_uploadFile;
+static String s_uploadName;
+static bool s_uploadFailed = false;
+
+static bool validName(const String& name) {
+    if (name.length() == 0 || name.length() > MAX_NAME_LENGTH) {
+        return false;
+    }
+    for (size_t i = 0; i < name.length(); i++) {
+        char c = name[i];
+        if (!isalnum(c) && c != '_' && c != '-') {
+            return false;
+        }
+    }
+    return true;
+}
+
+static String sheetPath(const char* name) {
+    return String(SPRITE_DIR) + name + ".pxs";
+}
+
+static void openSheet() {
+    if (!spriteStreamOpen(&s_stream, SPIFFS, sheetPath(s_name).c_str())) {
+        Serial.printf("Animation: can't play %s\n", sheetPath(s_name).c_str());
+    }
+}
+
+// Drop an upload that won't be installed (AsyncTCP task)
+static void abandonUpload() {
+    s_uploadFile.close();
+    SPIFFS.remove(UPLOAD_TEMP_PATH);
+    s_uploadRequest = nullptr;
+    s_uploadBusy = false;
+}
+
+void animationBegin() {
+    s_active = true;
+    openSheet();
+}
+
+void animationEnd() {
+    spriteStreamClose(&s_stream);
+    s_active = false;
+}
+
+size_t animationStateSize() {
+    return spriteStreamMemory(&s_stream);
+}
+
+// Switch sheets (applied by the render task, see CMD_SET_ANIMATION)
+void animationSelect(const char* name) {
+    spriteStreamClose(&s_stream);
+    strlcpy(s_name, name, sizeof(s_name));
+    if (s_active) {
+        openSheet();
+    }
+}
+
+// Replace sheet `name` with the finished upload and select it (applied by
+// the render task, see CMD_INSTALL_ANIMATION). Selections are applied by
+// the same task in the order they were made, so none can open the file
+// halfway through. The caller has switched out the current pattern, in
+// case it was streaming the old file.
+void animationInstall(const char* name) {
+    String path = sheetPath(name);
+    SPIFFS.remove(path);
+    if (SPIFFS.rename(UPLOAD_TEMP_PATH, path)) {
+        animationSelect(name);
+    } else {
+        Serial.printf("Animation: could not store %s\n", path.c_str());
+        SPIFFS.remove(UPLOAD_TEMP_PATH);
+    }
+    s_uploadBusy = false;
+}
+
+void animation(CRGB* leds) {
+    uint16_t duration = spriteStreamNext(&s_stream, leds);
+    if (duration == 0) {
+        // Nothing to play, check back now and then
+        fill_solid(leds, NUM_LEDS, CRGB::Black);
+        setFrameDelay(500);
+        return;
+    }
+    setFrameDelay(duration);
+}
+
+void setupAnimationPattern(AsyncWebServer* server) {
+    webServeAsset(server, "/animation", WEB_ANIMATION_HTML);
+
+    server->on("/animationlist", HTTP_GET, [](AsyncWebServerRequest *request) {
+        String json = "[";
+        File dir = SPIFFS.open("/sprites");
+        File file = dir.openNextFile();
+        while (file) {
+            String name = file.name();
+            name = name.substring(name.lastIndexOf('/') + 1);
+            if (name.endsWith(".pxs")) {
+                if (json.length() > 1) json += ",";
+                json += "\"" + name.substring(0, name.length() - 4) + "\"";
+            }
+            file = dir.openNextFile();
+        }
+        json += "]";
+        request->send(200, "application/json", json);
+    });
+
+    server->on("/animationselect", HTTP_GET, [](AsyncWebServerRequest *request) {
+        if (!request->hasParam("name") || !validName(request->getParam("name")->value())) {
+            request->send(400, "text/plain", "Bad name");
+            return;
+        }
+        if (!commandPostText(CMD_SET_ANIMATION, request->getParam("name")->value().c_str())) {
+            request->send(503, "text/plain", "Busy");
+            return;
+        }
+        request->send(200, "text/plain", "OK");
+    });
+
+    // Sheets are written to a temporary file, and the render task moves
+    // it into place once complete, so a half uploaded file is never
+    // played and the playing file is never removed from under it
+    server->on("/animationupload", HTTP_POST, [](AsyncWebServerRequest *request) {
+        if (request != s_uploadRequest) {
+            if (s_uploadBusy) {
+                request->send(409, "text/plain", "Another sheet is being uploaded, try again in a moment");
+            } else {
+                request->send(400, "text/plain", "Upload failed, expected a .pxs file");
+            }
+            return;
+        }
+        if (s_uploadFailed) {
+            abandonUpload();
+            request->send(400, "text/plain", "Upload failed, expected a .pxs file with a short name");
+            return;
+        }
+        // The render task installs it and plays it right away
+        s_uploadRequest = nullptr;
+        if (!commandPostText(CMD_INSTALL_ANIMATION, s_uploadName.c_str())) {
+            SPIFFS.remove(UPLOAD_TEMP_PATH);
+            s_uploadBusy = false;
+            request->send(503, "text/plain", "Busy");
+            return;
+        }
+        request->send(200, "text/plain", "Uploaded " + s_uploadName);
+    },
+    [](AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final) {
+        if (index == 0) {
+            if (s_uploadBusy.exchange(true)) {
+                return;   // answered 409 once the request is complete
+            }
+            s_uploadRequest = request;
+            // A client that goes away mid upload never gets an answer
+            request->onDisconnect([request]() {
+                if (s_uploadRequest == request) {
+                    abandonUpload();
+                }
+            });
+            s_uploadName = filename.endsWith(".pxs") ? filename.substring(0, filename.length() - 4) : "";
+            s_uploadFailed = !validName(s_uploadName);
+            if (!s_uploadFailed) {
+                s_uploadFile = SPIFFS.open(UPLOAD_TEMP_PATH, FILE_WRITE);
+                s_uploadFailed = !s_uploadFile;
+            }
+        }
+        if (request != s_uploadRequest || s_uploadFailed) {
+            return;
+        }
+        // Check the magic so a stray file can't end up in the list
+        if (index == 0 && (len < 2 || data[0] != 'P' || data[1] != 'X')) {
+            s_uploadFailed = true;
+        } else if (s_uploadFile.write(data, len) != len) {
+            s_uploadFailed = true;   // most likely out of space
+        }
+        if (final || s_uploadFailed) {
+            s_uploadFile.close();
+            if (s_uploadFailed) {
+                SPIFFS.remove(UPLOAD_TEMP_PATH);
+            }
+        }
+    });
+}
@@ -0,0 +1,18 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <FastLED.h>
+#include <ESPAsyncWebServer.h>
+
+// Plays a sprite sheet (.pxs, see src/utils/sprite_compiler.py) streamed
+// from /sprites on SPIFFS. Sheets can be uploaded and picked from the
+// /animation page without reflashing.
+void animation(CRGB* leds);
+void animationBegin();
+void animationEnd();
+size_t animationStateSize();
+void animationSelect(const char* name);
+void animationInstall(const char* name);
+void setupAnimationPattern(AsyncWebServer* server);
+
+#endif // ANIMATION_H
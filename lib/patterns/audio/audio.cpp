@@ -2,6 +2,7 @@
 #include "led_display.h"
 #include "patterns.h"
 #include "arduinoFFT.h"
+#include "webassets.h"
 
 #define MIC_PIN 34
 #define SAMPLES 1024          // Must be a power of 2
@@ -11,14 +12,20 @@
 #define DEBUG_INTERVAL 100   // Debug print interval in ms
 #define CENTER_BOOST 1.5     // Center column boost factor
 
+// FFT sample buffers (16KB), allocated only while the pattern runs
+struct AudioBuffers {
+    double vReal[SAMPLES];
+    double vImag[SAMPLES];
+};
+static AudioBuffers* s_buffers = nullptr;
+
 // FFT and sampling variables
-static double vReal[SAMPLES];
-static double vImag[SAMPLES];
 static uint16_t bandValues[NUM_BANDS];    // Changed to uint16_t to handle larger values
 static uint8_t peak[NUM_BANDS];          // Peak values for each band
 static unsigned long lastDebug = 0;
 static unsigned long samplingPeriodUs;
-static ArduinoFFT<double> FFT = ArduinoFFT<double>(vReal, vImag, SAMPLES, SAMPLING_FREQ);
+// Buffers are passed to every FFT call, so none are bound here
+static ArduinoFFT<double> FFT = ArduinoFFT<double>(nullptr, nullptr, SAMPLES, SAMPLING_FREQ);
 
 // Exponential moving average for noise floor
 static float noiseFloor[NUM_BANDS];
@@ -74,6 +81,22 @@ void setupAudio() {
     pinMode(MIC_PIN, INPUT);
 }
 
+void audioBegin() {
+    s_buffers = (AudioBuffers*)malloc(sizeof(AudioBuffers));
+    if (!s_buffers) {
+        Serial.println("Audio: not enough memory for FFT buffers");
+    }
+}
+
+void audioEnd() {
+    free(s_buffers);
+    s_buffers = nullptr;
+}
+
+size_t audioStateSize() {
+    return s_buffers ? sizeof(AudioBuffers) : 0;
+}
+
 void setupAudioPattern(AsyncWebServer* server) {
     // Handle parameter updates
     server->on("/audioupdate", HTTP_GET, [](AsyncWebServerRequest *request) { 
@@ -102,107 +125,13 @@ void setupAudioPattern(AsyncWebServer* server) {
     });
 
     // Serve the control panel HTML
-    server->on("/audio", HTTP_GET, [](AsyncWebServerRequest *request) {
-        String html = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-    <title>Audio Visualizer Controls</title>
-    <style>
-        body { font-family: Arial, sans-serif; margin: 20px; }
-        .control { margin: 20px 0; }
-        .slider-container { margin: 10px 0; }
-        .slider-label { display: inline-block; width: 150px; }
-        .button { padding: 10px; margin: 5px; cursor: pointer; }
-    </style>
-</head>
-<body>
-    <h2>Audio Visualizer Controls</h2>
-    
-    <div class="control">
-        <div class="slider-container">
-            <span class="slider-label">Noise Threshold:</span>
-            <input type="range" min="0" max="1000" value="348" id="noiseThreshold">
-            <span id="noiseThresholdValue">348</span>
-        </div>
-        
-        <div class="slider-container">
-            <span class="slider-label">Min Amplitude:</span>
-            <input type="range" min="0" max="1000" value="70" id="minAmplitude">
-            <span id="minAmplitudeValue">70</span>
-        </div>
-        
-        <div class="slider-container">
-            <span class="slider-label">Max Amplitude:</span>
-            <input type="range" min="1000" max="5000" value="5000" id="maxAmplitude">
-            <span id="maxAmplitudeValue">5000</span>
-        </div>
-        
-        <div class="slider-container">
-            <span class="slider-label">Scale Factor:</span>
-            <input type="range" min="1" max="10" value="1" id="scaleFactor">
-            <span id="scaleFactorValue">1</span>
-        </div>
-        
-        <div class="slider-container">
-            <span class="slider-label">Noise Alpha (%):</span>
-            <input type="range" min="1" max="100" value="45" id="noiseAlpha">
-            <span id="noiseAlphaValue">45</span>
-        </div>
-        
-        <div class="slider-container">
-            <span class="slider-label">Smoothing (%):</span>
-            <input type="range" min="0" max="100" value="46" id="smoothingFactor">
-            <span id="smoothingFactorValue">46</span>
-        </div>
-    </div>
-    
-    <div class="control">
-        <button class="button" onclick="changePattern(0)">Rainbow Bars</button>
-        <button class="button" onclick="changePattern(1)">Peaks Only</button>
-        <button class="button" onclick="changePattern(2)">Purple Bars</button>
-        <button class="button" onclick="changePattern(3)">Center Bars</button>
-        <button class="button" onclick="changePattern(4)">Changing Bars</button>
-        <button class="button" onclick="changePattern(5)">Waterfall</button>
-    </div>
-    
-    <script>
-        function updateSlider(id) {
-            const slider = document.getElementById(id);
-            const valueSpan = document.getElementById(id + 'Value');
-            valueSpan.textContent = slider.value;
-            
-            fetch('/audioupdate?' + id + '=' + slider.value)
-                .then(response => response.text())
-                .then(data => console.log('Updated:', id, data));
-        }
-        
-        function changePattern(pattern) {
-            fetch('/audioupdate?pattern=' + pattern)
-                .then(response => response.text())
-                .then(data => console.log('Pattern changed:', data));
-        }
-        
-        // Set up slider event listeners
-        const sliders = ['noiseThreshold', 'minAmplitude', 'maxAmplitude', 
-                        'scaleFactor', 'noiseAlpha', 'smoothingFactor'];
-        
-        sliders.forEach(id => {
-            const slider = document.getElementById(id);
-            slider.oninput = () => {
-                document.getElementById(id + 'Value').textContent = slider.value;
-            };
-            slider.onchange = () => updateSlider(id);
-        });
-    </script>
-</body>
-</html>)rawliteral";
-        request->send(200, "text/html", html);
-    });
+    webServeAsset(server, "/audio", WEB_AUDIO_HTML);
 }
 
 // Get the current sound level from the microphone
 uint16_t getSoundLevel() {
+    double* vReal = s_buffers->vReal;
+    double* vImag = s_buffers->vImag;
     uint16_t signalMax = 0;
     uint16_t signalMin = 4095;
     
@@ -239,6 +168,11 @@ float getCenterBias(uint8_t band) {
 void audio(CRGB* leds) {
     unsigned long currentMillis = millis();
     
+    setFrameDelay(10); // Small delay to prevent flickering
+    if (!s_buffers) return;
+    double* vReal = s_buffers->vReal;
+    double* vImag = s_buffers->vImag;
+    
     // Get sound level and run FFT
     uint16_t soundLevel = getSoundLevel();
     FFT.dcRemoval(vReal, SAMPLES);
@@ -328,9 +262,6 @@ void audio(CRGB* leds) {
             }
             break;
     }
-    
-    FastLED.show();
-    delay(10); // Small delay to prevent flickering
 }
 
 // Pattern-specific functions
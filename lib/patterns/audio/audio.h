@@ -16,6 +16,9 @@
 void setupAudio();
 void setupAudioPattern(AsyncWebServer* server);
 void audio(CRGB* leds);
+void audioBegin();
+void audioEnd();
+size_t audioStateSize();
 
 // Pattern-specific functions
 void audioRainbowBars(CRGB* leds, int band, int barHeight);
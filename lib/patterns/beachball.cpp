@@ -1,57 +1,41 @@
 #include <FastLED.h>
 #include <led_display.h>
-#include <math.h>
+#include <patterns.h>
 
 // Function declaration for pattern registration
 void beachBall(CRGB* leds);
 
-// Global variables for the beach ball pattern
-static float rotation = 0.0f;           // Current rotation angle in radians
-static const int centerX = 8;           // Center X (for 16x16 grid)
-static const int centerY = 8;           // Center Y
-static const int radius = 12;            // Radius of the beach ball
-static const float rotationSpeed = 0.09f; // Rotation speed, adjust as needed
+// Current rotation, 65536 to the turn like the polar table's angles
+static uint16_t rotation = 0;
+static const uint16_t rotationSpeed = 939; // about 0.09 radians per frame
 
 void beachBall(CRGB* leds) {
     // Clear the display
     fill_solid(leds, NUM_LEDS, CRGB::Black);
+
+    // Centered, and big enough to fill the corners (12 on a 16x16 panel)
+    const uint16_t radius = max(LED_WIDTH, LED_HEIGHT) * 3 / 4 * LED_POLAR_UNIT;
     
     // For each pixel, determine if it's within the beach ball radius and what color it should be
-    for (uint8_t y = 0; y < 16; y++) {
-        for (uint8_t x = 0; x < 16; x++) {
-            // Calculate distance from center to determine if pixel is inside ball
-            int16_t dx = x - centerX;
-            int16_t dy = y - centerY; 
-            float distance = sqrt(dx*dx + dy*dy);
+    for (uint16_t y = 0; y < LED_HEIGHT; y++) {
+        for (uint16_t x = 0; x < LED_WIDTH; x++) {
+            // Distance and angle from the center come from the polar table
+            const LedPolar& p = polarAt(x, y);
             
             // Only draw pixels inside the beach ball radius
-            if (distance <= radius) {
-                // Calculate angle in degrees [0..360)
-                float angle = atan2f((float)dy, (float)dx) * (180.0f / PI);
-                if (angle < 0) {
-                    angle += 360.0f;  // shift to [0..360)
-                }
-                
-                // Add the rotation offset (convert rotation from radians to degrees first)
-                float rotatedAngle = angle + (rotation * 180.0f / PI);
-                while (rotatedAngle >= 360.0f) {
-                    rotatedAngle -= 360.0f;
-                }
-                
-                // Map angle directly to hue as requested
-                uint8_t hue = map(rotatedAngle, 0, 360, 0, 255);
+            if (p.radius <= radius) {
+                // Map the rotated angle directly to hue, wrapping around
+                // with the 16-bit angle
+                uint8_t hue = (uint16_t)(p.angle + rotation) >> 8;
                 
                 // Color the pixel using HSV for vibrant colors
                 leds[XY(x, y)] = CHSV(hue, 255, 255);
             }
         }
     }
-    // Increment rotation for next frame
+    // Advance the rotation for the next frame
     rotation += rotationSpeed;
-    if (rotation >= 2*PI) {
-        rotation -= 2*PI;
-    }
     
     // Short delay each frame
-    delay(20);
-} 
\ No newline at end of file
+    setFrameDelay(20);
+} 
@@ -5,9 +5,9 @@
 #include <ESPAsyncWebServer.h>
 
 // Function declarations
-void nap(int wait);
 void clockCountdown(CRGB* leds);
 void setupClockPattern(AsyncWebServer* server);
 void resetClock();
+void clockApplyAction(const char* action, int totalSeconds);
 
 #endif // CLOCK_H 
\ No newline at end of file
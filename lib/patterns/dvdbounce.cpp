@@ -1,17 +1,18 @@
 #include <FastLED.h>
 #include <led_display.h>
+#include <fixmath.h>
 
 // Function declaration for pattern registration
 void dvdBounce(CRGB* leds);
 
 // Global state for the DVD bounce pattern
-static float x = 0;
-static float y = 0;
-static float dx = 0.5;  // X velocity
-static float dy = 0.3;  // Y velocity
-static float hue = 0; // Current hue for color shifting
-static const int rectWidth = 4;  // Small rectangle for 16x16 grid
-static const int rectHeight = 2; // Small rectangle for 16x16 grid
+static fix16 x = 0;
+static fix16 y = 0;
+static fix16 dx = fix16FromFloat(0.5);  // X velocity
+static fix16 dy = fix16FromFloat(0.3);  // Y velocity
+static uint8_t hue = 0; // Current hue for color shifting
+static const int rectWidth = 4;  // Small rectangle, sized for a 16x16 panel
+static const int rectHeight = 2;
 
 void dvdBounce(CRGB* leds) {
     // Update position
@@ -19,18 +20,15 @@ void dvdBounce(CRGB* leds) {
     y += dy;
 
     // Bounce off edges
-    if (x <= 0 || x + rectWidth >= 16) {
+    if (x <= 0 || x + fix16FromInt(rectWidth) >= fix16FromInt(LED_WIDTH)) {
         dx = -dx;
-        hue += 30; // Change color on bounce
+        hue += 21; // Change color on bounce, 30 degrees
     }
-    if (y <= 0 || y + rectHeight >= 16) {
+    if (y <= 0 || y + fix16FromInt(rectHeight) >= fix16FromInt(LED_HEIGHT)) {
         dy = -dy;
-        hue += 30; // Change color on bounce
+        hue += 21; // Change color on bounce
     }
 
-    // Keep hue in valid range (0-360)
-    if (hue >= 360) hue -= 360;
-
     // Clear the display (fill with black)
     fill_solid(leds, NUM_LEDS, CRGB::Black);
 
@@ -40,8 +38,8 @@ void dvdBounce(CRGB* leds) {
     hsv2rgb_rainbow(hsv, rgb);
 
     // Draw rectangle
-    for (int i = x; i < x + rectWidth && i < 16; i++) {
-        for (int j = y; j < y + rectHeight && j < 16; j++) {
+    for (int i = fix16ToInt(x); fix16FromInt(i) < x + fix16FromInt(rectWidth) && i < LED_WIDTH; i++) {
+        for (int j = fix16ToInt(y); fix16FromInt(j) < y + fix16FromInt(rectHeight) && j < LED_HEIGHT; j++) {
             if (i >= 0 && j >= 0) {
                 leds[XY(i, j)] = rgb;
             }
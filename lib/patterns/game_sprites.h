@@ -0,0 +1,92 @@
+#ifndef GAME_SPRITES_H
+#define GAME_SPRITES_H
+
+// Sprite sheets for the game character patterns, in the format described
+// in lib/sprites/sprites.h. Sheets marked for SPIFFS live in data/sprites.
+//
+// Generated by src/utils/sprite_compiler.py from
+// src/utils/sprites/sprites.json - edit the PNGs and manifest, not this file.
+
+#include <Arduino.h>
+
+// Pac-Man chomping (3 frames, 156 bytes)
+static const uint8_t pacSheet[] PROGMEM = {
+  0x50,0x58,0x01,0x10,0x10,0x03,0x03,0x02,0x00,0x00,0x00,0xFF,0x00,0x00,0xFF,0xFF,
+  0x00,0x21,0x21,0xFF,0xC8,0x00,0x00,0x2D,0x00,0x13,0x41,0x0D,0x42,0x83,0x07,0x40,
+  0xC0,0x41,0x85,0x03,0x41,0xC0,0x40,0x88,0x02,0x42,0x89,0x03,0x41,0x80,0x03,0x85,
+  0x02,0x8C,0x40,0x01,0x8B,0x41,0x01,0x8C,0x40,0x01,0x82,0x00,0x88,0x03,0x8A,0x04,
+  0x8A,0x05,0x88,0x08,0x84,0x14,0xC8,0x00,0x02,0x26,0x00,0x2B,0x40,0x0E,0x40,0x00,
+  0x05,0x06,0x00,0x02,0x06,0x05,0x01,0x01,0x08,0x04,0xC0,0x00,0x80,0x01,0x08,0x05,
+  0x0A,0x04,0x0B,0x05,0x0A,0x06,0x0A,0x06,0x09,0x07,0x09,0x06,0x40,0x00,0x0A,0x05,
+  0x40,0xC8,0x00,0x02,0x26,0x00,0x2B,0x07,0x07,0x82,0x0A,0x86,0x08,0x80,0x01,0x00,
+  0x00,0x82,0x00,0x41,0x07,0x80,0x00,0x00,0x00,0xC0,0x00,0x81,0x0D,0x80,0x1F,0x80,
+  0x10,0x81,0x0F,0x82,0x00,0x41,0x0C,0x83,0x0C,0x82,0x0E,0x14,
+};
+
+// Q*bert hopping (2 frames, 207 bytes)
+static const uint8_t qbertSheet[] PROGMEM = {
+  0x50,0x58,0x01,0x10,0x10,0x02,0x05,0x03,0x00,0x00,0x00,0xFF,0x66,0x00,0xFF,0x00,
+  0x33,0xFF,0xFF,0xCC,0x00,0x00,0x33,0xFF,0xFF,0xFF,0xDC,0x05,0x00,0x4D,0x00,0x1F,
+  0x07,0x23,0x09,0x44,0x22,0x07,0x61,0x40,0x61,0x40,0x20,0x41,0x08,0x40,0x01,0x40,
+  0x21,0x41,0x04,0x20,0x45,0x20,0x42,0x02,0x25,0x41,0x22,0x41,0x01,0x2A,0x42,0x00,
+  0x22,0x42,0x20,0x40,0x20,0x40,0x20,0x40,0x20,0x41,0x00,0x20,0x81,0x41,0x00,0x41,
+  0x20,0x44,0x01,0x40,0x81,0x40,0x02,0x45,0x03,0x41,0x03,0x44,0x0A,0x40,0x01,0x40,
+  0x09,0x21,0x40,0x01,0x22,0x05,0x21,0x40,0x01,0x22,0x40,0x02,0x20,0x03,0x02,0x5E,
+  0x00,0x08,0x23,0x0A,0x44,0x00,0x22,0x08,0xA1,0x00,0x40,0x00,0xA1,0x00,0x40,0x00,
+  0x20,0x00,0x41,0x07,0x01,0x01,0x01,0x00,0x40,0x02,0x40,0x06,0x20,0x00,0x01,0x01,
+  0x01,0x04,0x40,0x03,0x25,0x00,0x41,0x00,0x22,0x04,0x2A,0x04,0x22,0x00,0x42,0x01,
+  0x40,0x00,0x20,0x02,0x40,0x04,0x20,0x00,0x01,0x00,0x41,0x00,0x00,0x00,0x41,0x01,
+  0x44,0x00,0x01,0x00,0x40,0x00,0x01,0x01,0x02,0x01,0x44,0x00,0x03,0x00,0x41,0x00,
+  0x03,0x01,0x43,0x00,0x0A,0x01,0x02,0x01,0x0A,0x01,0x02,0x0F,0x00,0x00,0x40,
+};
+
+// Mario running (3 frames, 218 bytes)
+static const uint8_t marioSheet[] PROGMEM = {
+  0x50,0x58,0x01,0x10,0x10,0x03,0x03,0x02,0x00,0x00,0x00,0xBD,0x05,0x05,0x63,0x3C,
+  0xA5,0x85,0x50,0x05,0x96,0x00,0x00,0x47,0x00,0x04,0x44,0x09,0x48,0x06,0x82,0xC1,
+  0x80,0xC0,0x07,0x80,0xC0,0x80,0xC2,0x80,0xC2,0x05,0x80,0xC0,0x81,0xC2,0x80,0xC2,
+  0x04,0x81,0xC3,0x83,0x07,0xC6,0x05,0x83,0x41,0x81,0x05,0xC1,0x83,0x42,0x82,0xC2,
+  0x00,0xC2,0x00,0x81,0x40,0xC0,0x42,0x81,0xC1,0x00,0xC1,0x01,0x46,0x01,0x80,0x04,
+  0x48,0x81,0x03,0x49,0x81,0x02,0x81,0x42,0x02,0x42,0x81,0x02,0x82,0x0D,0x82,0x0A,
+  0x96,0x00,0x02,0x32,0x00,0x72,0x01,0x03,0x82,0x06,0x02,0x03,0x80,0x04,0x07,0x00,
+  0x82,0x01,0x40,0x00,0xC0,0x02,0xC0,0x00,0x06,0x00,0x83,0x04,0x40,0x01,0x05,0x01,
+  0x81,0x00,0xC2,0x03,0x07,0x01,0x80,0x00,0xC1,0x03,0x09,0x01,0x41,0x00,0x82,0x00,
+  0x09,0x00,0x86,0x06,0x02,0x00,0x83,0x96,0x00,0x00,0x3E,0x00,0x15,0x44,0x09,0x48,
+  0x06,0x82,0xC1,0x80,0xC0,0x07,0x80,0xC0,0x80,0xC2,0x80,0xC2,0x05,0x80,0xC0,0x81,
+  0xC2,0x80,0xC2,0x04,0x81,0xC3,0x83,0x07,0xC6,0x07,0x83,0x40,0x80,0x00,0xC0,0x06,
+  0xC0,0x85,0xC2,0x04,0xC1,0x40,0x84,0xC1,0x05,0x81,0x46,0x06,0x80,0x47,0x05,0x81,
+  0x42,0x00,0x42,0x06,0x80,0x03,0x82,0x0C,0x83,0x04,
+};
+
+// Ghost: 1-2 walking, 3-6 looking around (6 frames, 418 bytes)
+static const uint8_t ghostSheet[] PROGMEM = {
+  0x50,0x58,0x01,0x10,0x10,0x06,0x03,0x02,0x00,0x00,0x00,0xFF,0x00,0x00,0xDE,0xDE,
+  0xFF,0x21,0x21,0xFF,0xF4,0x01,0x00,0x3F,0x00,0x15,0x43,0x09,0x47,0x06,0x49,0x04,
+  0x42,0x81,0x43,0x81,0x40,0x03,0x41,0x83,0x41,0x83,0x03,0x41,0x81,0xC1,0x41,0x81,
+  0xC1,0x02,0x42,0x81,0xC1,0x41,0x81,0xC1,0x40,0x01,0x43,0x81,0x43,0x81,0x41,0x01,
+  0x4D,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x41,0x00,0x42,0x01,0x42,0x00,0x41,0x01,
+  0x40,0x02,0x41,0x01,0x41,0x02,0x40,0x10,0xF4,0x01,0x00,0x3B,0x00,0x15,0x43,0x09,
+  0x47,0x06,0x49,0x04,0x42,0x81,0x43,0x81,0x40,0x03,0x41,0x83,0x41,0x83,0x03,0x41,
+  0x81,0xC1,0x41,0x81,0xC1,0x02,0x42,0x81,0xC1,0x41,0x81,0xC1,0x40,0x01,0x43,0x81,
+  0x43,0x81,0x41,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x43,0x00,0x43,0x00,
+  0x43,0x02,0x41,0x02,0x41,0x02,0x41,0x11,0x84,0x03,0x00,0x3F,0x00,0x15,0x43,0x09,
+  0x47,0x06,0x49,0x04,0x40,0x81,0x43,0x81,0x42,0x03,0x83,0x41,0x83,0x41,0x03,0xC1,
+  0x81,0x41,0xC1,0x81,0x41,0x02,0x40,0xC1,0x81,0x41,0xC1,0x81,0x42,0x01,0x41,0x81,
+  0x43,0x81,0x43,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x41,0x00,0x42,0x01,
+  0x42,0x00,0x41,0x01,0x40,0x02,0x41,0x01,0x41,0x02,0x40,0x10,0x84,0x03,0x00,0x39,
+  0x00,0x15,0x43,0x09,0xC1,0x43,0xC1,0x06,0x80,0xC1,0x80,0x41,0x80,0xC1,0x80,0x04,
+  0x40,0x83,0x41,0x83,0x40,0x03,0x40,0x83,0x41,0x83,0x40,0x03,0x41,0x81,0x43,0x81,
+  0x41,0x02,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x43,0x00,
+  0x43,0x00,0x43,0x02,0x41,0x02,0x41,0x02,0x41,0x11,0x84,0x03,0x00,0x41,0x00,0x15,
+  0x43,0x09,0x47,0x06,0x49,0x04,0x4B,0x03,0x41,0x81,0x43,0x81,0x41,0x03,0x40,0x83,
+  0x41,0x83,0x40,0x02,0x41,0x83,0x41,0x83,0x41,0x01,0x41,0x80,0xC1,0x80,0x41,0x80,
+  0xC1,0x80,0x41,0x01,0x42,0xC1,0x43,0xC1,0x42,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,
+  0x41,0x00,0x42,0x01,0x42,0x00,0x41,0x01,0x40,0x02,0x41,0x01,0x41,0x02,0x40,0x10,
+  0x84,0x03,0x00,0x3D,0x00,0x15,0x43,0x09,0xC1,0x43,0xC1,0x06,0x80,0xC1,0x80,0x41,
+  0x80,0xC1,0x80,0x04,0x40,0x83,0x41,0x83,0x40,0x03,0x40,0x83,0x41,0x83,0x40,0x03,
+  0x41,0x81,0x43,0x81,0x41,0x02,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,0x4D,0x01,
+  0x4D,0x01,0x41,0x00,0x42,0x01,0x42,0x00,0x41,0x01,0x40,0x02,0x41,0x01,0x41,0x02,
+  0x40,0x10,
+};
+
+#endif // GAME_SPRITES_H
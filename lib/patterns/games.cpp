@@ -2,99 +2,57 @@
 #include <led_display.h>
 #include <math.h>
 #include "patterns.h"
-
-// Forward declarations
-void loadArray(const long arr[], CRGB* leds, const long Color /*= 0*/, const long replacementColor /*= 0*/); 
-void nap(int wait);
+#include <sprites.h>
+#include "game_sprites.h"
 
 // Ghost color variable
 int ghostcolor = 0;
 
-void pac(CRGB* leds) {
-  
-  const long pac1[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0x2121FF,0xFF0000,0xFF0000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0x2121FF,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0xFF0000,0xFF0000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000};
-  const long pac2[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0x2121FF,0xFF0000,0xFF0000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0x2121FF,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0x2121FF,0x000000,0xFFFF00,0xFFFF00,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000};
-  const long pac3[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0x2121FF,0xFF0000,0xFF0000,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0x000000,0xFFFF00,0xFFFF00,0xFF0000,0x2121FF,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFFFF00,0xFFFF00,0x000000,0x000000,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0x2121FF,0x000000,0xFFFF00,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0xFFFF00,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000};
-
+// Sprite players restart from their first (full) frame whenever the
+// pattern is switched in, since later frames may be deltas
+static SpritePlayer s_pacPlayer;
+static SpritePlayer s_qbertPlayer;
+static SpritePlayer s_marioPlayer;
 
+void pacBegin() { spritePlayerStart(&s_pacPlayer, pacSheet); }
+void qbertBegin() { spritePlayerStart(&s_qbertPlayer, qbertSheet); }
+void marioBegin() { spritePlayerStart(&s_marioPlayer, marioSheet); }
 
-  loadArray(pac1,leds); nap(200);
-  loadArray(pac3,leds); nap(200);
-  loadArray(pac2,leds); nap(200);
-  loadArray(pac1,leds); nap(200);
-  loadArray(pac3,leds); nap(200);
-  loadArray(pac2,leds); nap(200);
+void pac(CRGB* leds) {
+  setFrameDelay(spritePlayerNext(&s_pacPlayer, leds));
 }
 void qbert(CRGB* leds) {
-  const long Qbert01[] PROGMEM = { 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0xff6600, 0xff6600, 0x000000, 0x000000, 0x000000, 0xff0033, 0xff0033, 0xff6600, 0xff0033, 0xffffcc, 0xffffcc, 0xff0033, 0xffffcc, 0xffffcc, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0xff0033, 0xff6600, 0xff6600, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff0033, 0xff0033, 0xff6600, 0xff6600, 0xff6600, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0x000000, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff6600, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0xff0033, 0xff6600, 0xff0033, 0xff6600, 0xff0033, 0xff6600, 0xff0033, 0xff0033, 0x000000, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0xff0033, 0xff0033, 0x000000, 0xff0033, 0xff0033, 0x000033, 0x000033, 0xff6600, 0x000000, 0x000000, 0xff0033, 0x000033, 0x000033, 0xff0033, 0x000000, 0x000000, 0x000000, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0xff0033, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0x000000, 0x000000,0x000000, 0x000000, 0xff6600, 0xff6600, 0xff6600, 0x000000, 0x000000, 0xff0033, 0xff6600, 0xff6600, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff0033, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff6600, 0xff0033, 0x000000, 0x000000, 0x000000 };
-  const long Qbert02[] PROGMEM ={ 0x000000, 0x000000, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0xff6600, 0xff6600, 0x000000, 0x000000, 0x000000, 0xff0033, 0xff0033, 0xff6600, 0xff0033, 0xffffff, 0xffffff, 0xff0033, 0xffffff, 0xffffff, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0xff0033, 0xff6600, 0xff6600, 0xff0033, 0x000000, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0xff0033, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0xff6600, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff0033, 0xff0033, 0xff6600, 0xff6600, 0xff6600, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0xff6600, 0x000000, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff6600, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0xff0033, 0xff6600, 0xff0033, 0xff6600, 0xff0033, 0xff6600, 0xff0033, 0xff0033, 0x000000, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff6600, 0xff0033, 0xff0033, 0x000000, 0xff0033, 0xff0033, 0x000000, 0x000000, 0xff6600, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0x000000, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0xff0033, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0xff0033, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0x000000, 0xff0033, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff6600, 0x000000, 0x000000, 0xff0033, 0xff6600, 0xff6600, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff0033, 0x000000, 0x000000, 0xff6600, 0xff6600, 0xff6600, 0xff0033, 0x000000, 0x000000, 0x000000 };
-  loadArray(Qbert01,leds); nap(1500);
-  loadArray(Qbert02,leds); nap(800);
+  // Crouch for longer than the jump (per-frame durations in the sheet)
+  setFrameDelay(spritePlayerNext(&s_qbertPlayer, leds));
 }
 
 void mario(CRGB* leds) {
-  const long mario1[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x633CA5,0x855005,0x855005,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x855005,0x633CA5,0x855005,0x855005,0x855005,0x633CA5,0x855005,0x855005,0x855005,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x855005,0x855005,0x633CA5,0x855005,0x855005,0x855005,0x633CA5,0x633CA5,0x855005,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x855005,0x855005,0x855005,0x855005,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x855005,0x855005,0x855005,0x855005,0x855005,0x855005,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0xBD0505,0xBD0505,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x855005,0x855005,0x633CA5,0x633CA5,0x633CA5,0xBD0505,0xBD0505,0xBD0505,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x855005,0x855005,0x855005,0x855005,0x855005,0x000000,0x633CA5,0x633CA5,0xBD0505,0x855005,0xBD0505,0xBD0505,0xBD0505,0x633CA5,0x633CA5,0x855005,0x855005,0x000000,0x000000,0x000000,0x633CA5,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x855005,0x855005,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000};
-  const long mario2[] PROGMEM =  {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x633CA5,0x855005,0x855005,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x855005,0x633CA5,0x855005,0x855005,0x855005,0x633CA5,0x855005,0x855005,0x855005,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x855005,0x855005,0x633CA5,0x855005,0x855005,0x855005,0x633CA5,0x633CA5,0x855005,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x855005,0x855005,0x855005,0x855005,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x855005,0x855005,0x855005,0x855005,0x855005,0x855005,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0xBD0505,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0xBD0505,0xBD0505,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x633CA5,0xBD0505,0xBD0505,0x855005,0xBD0505,0xBD0505,0x855005,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0x633CA5,0x633CA5,0x855005,0x855005,0x855005,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0x855005,0x855005,0x633CA5,0xBD0505,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000 };
-  const long mario3[] PROGMEM =  {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x633CA5,0x855005,0x855005,0x633CA5,0x855005,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x855005,0x855005,0x633CA5,0x855005,0x855005,0x855005,0x633CA5,0x855005,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x855005,0x633CA5,0x633CA5,0x855005,0x855005,0x855005,0x633CA5,0x855005,0x855005,0x855005,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x855005,0x855005,0x855005,0x855005,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x855005,0x855005,0x855005,0x855005,0x855005,0x855005,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x000000,0x633CA5,0xBD0505,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x855005,0x855005,0x855005,0x000000,0x000000,0x000000,0x000000,0x000000,0x855005,0x855005,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0xBD0505,0x855005,0x855005,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0xBD0505,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0xBD0505,0xBD0505,0xBD0505,0x000000,0xBD0505,0xBD0505,0xBD0505,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x633CA5,0x633CA5,0x633CA5,0x633CA5,0x000000,0x000000,0x000000,0x000000,0x000000 };
-  loadArray(mario1,leds);nap(150);
-  loadArray(mario2,leds);nap(150);
-  loadArray(mario3,leds);nap(150);
+  setFrameDelay(spritePlayerNext(&s_marioPlayer, leds));
 }
 
-  // made global, for some reason this doesn't load past wa7 when inline in function. 
-  const long wa1[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0C4854,0x2C8596,0x18A9BA,0x6FABB5,0xBAC6C9,0x535D67,0x000000,0x000000,0x000000,0x000000,0x131314,0xC9CBCA,0xB9D6DA,0xE8EFF8,0x98E7F4,0x44DAED,0x67EBFE,0x6FC9D6,0x0A1627,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x30425A,0x79C7FF,0x78DAFF,0x77FEFF,0x67FEFF,0x34F0FF,0x88FEFF,0xFDFFFF,0xEBFFFF,0xDCD6D1,0x000000,0x000000,0xCAE7EC,0xEBFFFF,0xBDFFFF,0x77FEFF,0x45FDFF,0x56EBFE,0x99EBFF,0x94D6F6,0x061017,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0A1627,0x9CDEFF,0xA5E7FF,0xADE7FF,0x78DAFF,0x88EBFF,0x77FEFF,0x98FEFF,0xC9FFFF,0xB9D6DA,0x667485,0x535D67,0x4FA6B4,0x88FEFF,0xADFFFF,0x98FEFF,0xA0F7FF,0x68CAFE,0x69A5EF,0x9DD6F7,0x94D6FF,0x94D6FF,0x3D5881,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x3D5881,0x90C6F6,0x86BBFE,0x90C6F6,0x8BB5F1,0xA5EFFF,0xBDFFFF,0x88FEFF,0x77FEFF,0x4FC8D8,0x000000,0x000000,0x4DB8CC,0x88EBFF,0x88EBFF,0x92DEFF,0xA7DCFF,0x669CE5,0x529CF7,0x5386B9,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x76BAFF,0x030811,0x8DB9C7,0x538CD6,0x669CE5,0x76BAFF,0x57A7FD,0x83CEFF,0x8CCEFF,0x556B9C,0x2D6879,0x000000,0x000000,0x000000,0x000000,0x000000,0x6B8DB7,0x529CF7,0x529CF7,0x183252,0x829DD0,0x194469,0x000008,0x0F2437,0x000000,0x4484CC,0x183252,0x000000,0x6995D4,0x457AB9,0x3973B6,0x0F2437,0x000000,0x30425A,0x578ACA,0x69A5EF,0x316398,0x264973,0x556B9C,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x397BC0,0x0A1627,0x000000,0x6995D4,0x5694DC,0x264973,0x000000,0x000000,0x4673AB,0x000008,0x76A6E7,0x183252,0x000000,0x393838,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x080808,0x000000,0x000000,0x000808,0x559AEB,0x205380,0x194469,0x0A1627,0x000000,0x264973,0x000000,0x9CD6FF,0x3D5881,0x000000,0x0F2437,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x0A1627,0x6995D4,0x838188,0x000000};
-  const long wa2[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0C4854,0x167589,0x1A98AC,0x708C95,0xAEB3B5,0x535D67,0x000000,0x000000,0x000000,0x000000,0x212121,0xC9CBCA,0xCAD9DA,0xE8EFF8,0xA5EFF7,0x2DC8DD,0x7BE7F7,0x6FC9D6,0x183252,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x3D5881,0x84C6FF,0x78DAFF,0x77FEFF,0x67FEFF,0x45FDFF,0x88FEFF,0xFDFFFF,0xEBFFFF,0xDACDC8,0x000000,0x000000,0xCAE7EC,0xEBFFFF,0xB5FFFF,0x77FEFF,0x56FEFF,0x56DBFD,0xA5EFFF,0x9CDEFF,0x000808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0xA7DCFF,0xA5E7FF,0xADEFFF,0x68DAFE,0xA0F7FF,0x98FEFF,0x88FEFF,0xBDFFFF,0xCAE7EC,0x667485,0x535D67,0x4FA6B4,0x67FEFF,0x98FEFF,0x98FEFF,0xA0F7FF,0x79C7FF,0x76ADF8,0x94D6F6,0x94D6FF,0x94D6FF,0x3D5881,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x316398,0x84C6FF,0x8CC6FF,0xA7DCFF,0x9CD6FF,0x92DEF3,0xA5FFFF,0x98FEFF,0x77FEFF,0x4FC8D8,0x000000,0x000000,0x6FC9D6,0x77EBFE,0xA5FFFF,0x92DEFF,0x97B8E9,0x6995D4,0x57A7FD,0x6995D4,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0x4A6790,0x183252,0x8D8F93,0x538CD6,0x547BB7,0x76BAFF,0x57A7FD,0x9CD6FF,0x8CCEFF,0x77B8EC,0x6B8DB7,0x000000,0x000000,0x000000,0x000000,0x000000,0x6B8DB7,0x529CF7,0x57A7FD,0x535D67,0x8BB5F1,0x264973,0x061017,0x183252,0x0A1627,0x264973,0x194469,0x000000,0x6995D4,0x346BA7,0x4484CC,0x000000,0x000000,0x578ACA,0x5694DC,0x6995D4,0x194469,0x30425A,0x547BB7,0x000000,0x000000,0x000000,0x080808,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x457AB9,0x183252,0x000000,0x2C578B,0x538CD6,0x667DA8,0x000000,0x000008,0x4A6790,0x000000,0x556B9C,0x194469,0x061017,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x538CD6,0x183252,0x205380,0x194469,0x061017,0x3973B6,0x000008,0x9CC6F5,0x183252,0x030811,0x30425A,0x000808,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000008,0x5386B9,0x829DD0,0x000000};
-  const long wa3[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0C4854,0x167589,0x1A98AC,0x708C95,0x8D8F93,0x535D67,0x000000,0x000000,0x000000,0x000000,0x212121,0xDACDC8,0xCAD9DA,0xEBF7F6,0xADEFF7,0x2DC8DD,0x7BE7F7,0x4FC8D8,0x264973,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x4A6790,0x79C7FF,0x78DAFF,0x77EBFE,0x56FEFF,0x45FDFF,0x88FEFF,0xFDFFFF,0xEBF7F6,0xDACDC8,0x000000,0x000000,0xDAE7EA,0xDAFFFF,0xA5FFFF,0x77FEFF,0x56FEFF,0x44DBFE,0xA5EFFF,0x9CDEFF,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0xA7DCFF,0xA5E7FF,0xADEFFF,0x68DAFE,0x98FEFF,0x88FEFF,0x67FEFF,0xBDFFFF,0xCAE7EC,0x667485,0x667485,0x91CBD5,0x67EBFE,0x77FEFF,0xA5FFFF,0x88EBFF,0x79C7FF,0x76ADF8,0x96CBFF,0x9CD6FF,0x94D6FF,0x3D5881,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x2F65A3,0x76BAFF,0x84C6FF,0x8CCEFF,0x9CD6FF,0x8DCEF0,0x77EBFE,0xA5FFFF,0x67FEFF,0x65CCE4,0x000000,0x000000,0x6FC9D6,0x77EBFE,0xC9FFFF,0x92DEFF,0x69A5EF,0x578ACA,0x66ABFD,0x86ABE7,0x061017,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x183252,0x000000,0x183252,0x212121,0x538CD6,0x4673AB,0x76ADF8,0x57A7FD,0xA7CCFF,0xB8ECFE,0x84C6FF,0x5996C8,0x000000,0x000000,0x000000,0x000000,0x000000,0x5577A7,0x559AEB,0x66ABFD,0x212121,0x86BBFE,0x427BC6,0x5577A7,0x061017,0x76A6E7,0x000000,0x0F2437,0x000000,0x2C578B,0x4995DD,0x436AA1,0x000000,0x000000,0x457AB9,0x5996C8,0x3D5881,0x061017,0x061017,0x436AA1,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x578ACA,0x4A6790,0x0F2437,0x0F2437,0x397BC0,0xA5A1C8,0x183252,0x5577A7,0x0A1627,0x000000,0x547BB7,0x5386B9,0x000000,0x000000,0x0A1627,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x6B8DB7,0x061017,0x205380,0x194469,0x5577A7,0x478CD8,0x000000,0x667DA8,0x000008,0x556B9C,0x061017,0x0F2437,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x3D5881,0x96CBFF,0x30425A};
-  const long wa4[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x183252,0x167589,0x148898,0x708C95,0x708C95,0x535D67,0x000000,0x000000,0x000000,0x000000,0x2A2B2D,0xBAC6C9,0xDAE7EA,0xEBF7F6,0xB5F7F7,0x2DC8DD,0x7BE7F7,0x4DB8CC,0x2F65A3,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x205380,0x79C7FF,0x78DAFF,0x67EBFE,0x56FEFF,0x45FDFF,0x88FEFF,0xEBFFFF,0xFDFFFF,0xC9CBCA,0x000000,0x000000,0xCDDDEA,0xC9EEFA,0xA5FFFF,0x77FEFF,0x34F0FF,0x44DBFE,0xADF7FF,0x9CDEFF,0x0A1627,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0xA7DCFF,0xA5E7FF,0xADE7FF,0x68DAFE,0x88FEFF,0x88FEFF,0x77FEFF,0xC9FFFF,0xDAEFF5,0x838188,0x708C95,0x91CBD5,0x7BE7F7,0x67FEFF,0x98FEFF,0x88EBFF,0x68CAFE,0x76BAFF,0x9CD6FF,0x9CD6FF,0x9CD6FF,0x3D5881,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x3973B6,0x84C6FF,0x76BAFF,0x8CCEFF,0x83CEFF,0x83CEFF,0x77EBFE,0xADFFFF,0x77FEFF,0x4FC8D8,0x000000,0x000000,0x78CCE6,0x77FEFF,0xBDFFFF,0xB5F7FF,0x669CE5,0x69A5EF,0x68B7FF,0x90C6F6,0x0F2437,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x162121,0x183252,0x669CE5,0x4673AB,0x76ADF8,0x57A7FD,0x76ADF8,0xA5E7FF,0x8CCEFF,0x4DB8CC,0x000000,0x000000,0x0A1627,0x194469,0x000000,0x436AA1,0x4A95E8,0x57A7FD,0x000000,0x99AAE1,0x397BC0,0x69A5EF,0x000000,0x86BBFE,0x0F2437,0x000000,0x000000,0x0A1627,0x57A7FD,0x000000,0x000000,0x000000,0x2C578B,0x6B8DB7,0x316398,0x000000,0x000000,0x316398,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x264973,0x3573AF,0x457AB9,0x030811,0x264973,0x829DD0,0x457AB9,0x76A6E7,0x000000,0x000000,0x578ACA,0x8BB5F1,0x000000,0x000000,0x264973,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x30425A,0x000000,0x194469,0x264973,0x84C6F2,0x4995DD,0x000000,0x183252,0x000000,0x6995D4,0x205380,0x2C578B,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x2A2B2D,0x86ABE7,0x86ABE7};
-  const long wa5[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0x2D6879,0x148898,0x708C95,0x667485,0x7B7575,0x000000,0x000000,0x000000,0x000000,0x2A2B2D,0xC9CBCA,0xDAE7EA,0xEBF7F6,0xC1F7F7,0x2DC8DD,0x56EBFE,0x30B6CF,0x5386B9,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0x76BAFF,0x68CAFE,0x67EBFE,0x56FEFF,0x45FDFF,0x88FEFF,0xDAFFFF,0xFDFFFF,0xC9CBCA,0x000000,0x000000,0xEAECEB,0xB9DEE5,0xA5FFFF,0x67FEFF,0x34F0FF,0x43EAFE,0xADF7FF,0x9CDEFF,0x30425A,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0x9CDEFF,0xA5E7FF,0xADE7FF,0x68DAFE,0x67FEFF,0xA5FFFF,0x56FEFF,0xC0F7FF,0xFDFFFF,0x8D8F93,0x4FA6B4,0xAAD6DE,0x88EBFF,0x56EBFE,0x88FEFF,0x78DAFF,0x68CAFE,0x76ADF8,0x9CD6FF,0x9CD6FF,0x9CDEFF,0x3D5881,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x457AB9,0x76BAFF,0x76BAFF,0x84C6FF,0x79C7FF,0xA5E7FF,0x92DEFF,0xBDFFFF,0x77FEFF,0x4FC8D8,0x0F2437,0x000000,0x4DB8CC,0x88FEFF,0xC9FFFF,0x9CDEF0,0x86ADF8,0x8CCEFF,0x76BAFF,0x9DD6F7,0x183252,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x76A6E7,0x76A6E7,0x4673AB,0x69A5EF,0x57A7FD,0x69A5EF,0xADE7FF,0x84C6FF,0x4DB8CC,0x000000,0x000000,0x4A6790,0x5996C8,0x061017,0x3D5881,0x4484CC,0x66ABFD,0x2A2B2D,0x2C578B,0x436AA1,0x76A6E7,0x000000,0x4A6790,0x5386B9,0x000000,0x000000,0x0F2437,0x4484CC,0x0A1627,0x000000,0x000000,0x194469,0x578ACA,0x829DD0,0x000000,0x000000,0x4673AB,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000008,0x000000,0x000000,0x000000,0x669CE5,0x478CD8,0x205380,0x000000,0x556B9C,0x4484CC,0x829DD0,0x000000,0x183252,0x538CD6,0x77B8EC,0x000000,0x000000,0x5694DC,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000008,0x264973,0x77B8EC,0x397BC0,0x030811,0x0A1627,0x000000,0x3573AF,0x578ACA,0x2F65A3,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0A1627,0x000000,0x000000,0x436AA1,0x9CD6FF};
-  const long wa6[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0x2D6879,0x1A98AC,0x708C95,0x8D8F93,0x97867E,0x000000,0x000000,0x000000,0x080808,0x393838,0xC9CBCA,0xE5E7DE,0xEBF7F6,0xC0F7FF,0x57CCE6,0x43EAFE,0x42A8E4,0x4484CC,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x68B7FF,0x68CAFE,0x67EBFE,0x56FEFF,0x45FDFF,0x88FEFF,0xDAFFFF,0xE8EFF8,0xC9CBCA,0x000000,0x080808,0xEAECEB,0xB9DEE5,0x88FEFF,0x67FEFF,0x34F0FF,0x43EAFE,0xA5EFFF,0x94D6FF,0x2C578B,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0x9CDEFF,0xA5E7FF,0xADE7FF,0x57CAFE,0x77FEFF,0x67FEFF,0x67FEFF,0xC9FFFF,0xE8EFF8,0x667485,0x6FABB5,0x98D8E3,0x7BE7F7,0x67EBFE,0x77EBFE,0x7FCEF5,0x57B9FE,0x77B8EC,0x94D6F6,0x9CDEFF,0x9CDEFF,0x2D6879,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x457AB9,0x66ABFD,0x68B7FF,0x79C7FF,0x68B7FF,0xB5F7FF,0xA5E7FF,0xB5FFFF,0x98FEFF,0x20C2D6,0x106373,0x000000,0x30B6CF,0x98FEFF,0xBDFFFF,0x76A6E7,0x76BAFF,0xA5E7FF,0x76BAFF,0x84C6FF,0x5577A7,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x76ADF8,0x76ADF8,0x578ACA,0x57A7EB,0x57A7FD,0x69A5EF,0x94D6FF,0x8CCEFF,0x56B9E7,0x000000,0x000000,0x5996C8,0x76A6E7,0x0F2437,0x436AA1,0x578ACA,0x4CACF6,0x0A1627,0x3973B6,0x183252,0x6B8DB7,0x183252,0x000000,0x578ACA,0x000000,0x000000,0x0A1627,0x0F2437,0x4673AB,0x000000,0x000000,0x2C578B,0x6995D4,0x3D5881,0x000000,0x000000,0x547BB7,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x84C6F2,0x559AEB,0x205380,0x000000,0x0F2437,0x346BA7,0x5694DC,0x000000,0x316398,0x538CD6,0x547BB7,0x194469,0x205380,0x4A95E8,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x061017,0x000000,0x000000,0x131314,0x2C578B,0x5577A7,0x264973,0x030811,0x3D5881,0x183252,0x316398,0x316398,0x0A1627,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x2C578B,0x0A1627,0x000000,0x194469,0x90C6F6};
-  const long wa7[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x3B4041,0x167589,0x1A98AC,0x8797AC,0x8D8F93,0xAA9490,0x000000,0x000000,0x000000,0x000000,0x4D484A,0xDCD6D1,0xEAECEB,0xFDFFFF,0xB5F7FF,0x57CCE6,0x44DBFE,0x42A8E4,0x4995DD,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x4484CC,0x57B9FE,0x56DBFD,0x67FEFF,0x56FEFF,0x77FEFF,0xC9FFFF,0xDBF7F7,0xC9CBCA,0x000000,0x393838,0xEAECEB,0xAADEE8,0x88FEFF,0x56FEFF,0x34F0FF,0x43EAFE,0x99EBFF,0x9CDEFF,0x316398,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0x9CDEFF,0xA5E7FF,0xADEFFF,0x45B9EA,0x56FEFF,0x67FEFF,0x45FDFF,0xB5F7FF,0xB9DEE5,0x708C95,0x98D8E3,0x88DAE8,0x77FEFF,0x67EBFE,0x77FEFF,0x66BBEB,0x57A7FD,0x77B8EC,0x9DD6F7,0x94D6FF,0x9CD6FF,0x194469,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x316398,0x66ABFD,0x66ABFD,0x79C7FF,0x57A7FD,0xB5F7FF,0x99EBFF,0xC9FFFF,0xADFFFF,0x4FC8D8,0x1A98AC,0x162121,0x3FCAE8,0xADFFFF,0xB5FFFF,0x4CACF6,0x68B7FF,0xA5E7FF,0x76BAFF,0x9CD6FF,0x547BB7,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000008,0x86ABE7,0x669CE5,0x578ACA,0x69A5EF,0x57A7FD,0x69A5EF,0x8CCEFF,0x94D6FF,0x66BBEB,0x000000,0x000000,0x86ABE7,0x76A6E7,0x061017,0x578ACA,0x4484CC,0x578ACA,0x0A1627,0x397BC0,0x183252,0x4A6790,0x264973,0x000000,0x8D8F93,0x000000,0x000000,0x061017,0x0A1627,0x547BB7,0x000000,0x000000,0x4673AB,0x316398,0x0F2437,0x000000,0x000000,0x547BB7,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x8BB5F1,0x4A9CF0,0x194469,0x000000,0x000000,0x194469,0x559AEB,0x000808,0x547BB7,0x3887C7,0x264973,0x578ACA,0x316398,0x578ACA,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x30425A,0x030811,0x000000,0x0F2437,0x316398,0x4A6790,0x061017,0x183252,0x3D5881,0x194469,0x264973,0x183252,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x578ACA,0x194469,0x000000,0x0F2437,0x6B8DB7};
-  const long wa8[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0A1627,0x167589,0x1A98AC,0x6FABB5,0x708C95,0xB7A79F,0x000000,0x000000,0x000000,0x000000,0x7B7575,0xD9DBDB,0xDAE7EA,0xFDFFFF,0xB5F7FF,0x57CCE6,0x3FCAE8,0x45B9EA,0x478CD8,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x061017,0x4CACF6,0x56DBFD,0x67FEFF,0x67FEFF,0x67FEFF,0xBDFFFF,0xEBFFFF,0xD9DBDB,0x000000,0x535D67,0xEAECEB,0xAADEE8,0x77FEFF,0x56FEFF,0x34F0FF,0x77EBFE,0xA5EFFF,0x94D6FF,0x346BA7,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0x9CDEFF,0xA5E7FF,0xADE7FF,0x42A8E4,0x56EBFE,0x67FEFF,0x45FDFF,0xADF7FF,0xAADEE8,0x8797AC,0x6FC9D6,0xA5EFF7,0x77FEFF,0xA5EFF7,0x56FEFF,0x66BBEB,0x4A9CF0,0x76A6E7,0x94D6F6,0x94D6F6,0x9CD6FF,0x183252,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x183252,0x57A7FD,0x66ABFD,0x79C7FF,0x4A9CF0,0xA5E7FF,0x78DAFF,0xB5FFFF,0xB5FFFF,0x6FC9D6,0x20C2D6,0x0C4854,0x67DAEC,0xB5FFFF,0xB5FFFF,0x68B7FF,0x68B7FF,0x94D6FF,0x76ADF8,0x8CCEFF,0x538CD6,0x183252,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x030811,0x6B8DB7,0x436AA1,0x669CE5,0x5694DC,0x66ABFD,0x86ABE7,0x76BAFF,0x96CBFF,0x7FCEF5,0x000000,0x000000,0x76A6E7,0x5996C8,0x000808,0x538CD6,0x86BBFE,0x205380,0x061017,0x4484CC,0x436AA1,0x264973,0x264973,0x000000,0x131314,0x000000,0x000000,0x000000,0x578ACA,0x2C578B,0x000000,0x0A1627,0x346BA7,0x2C578B,0x0A1627,0x000000,0x000000,0x436AA1,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x4CACF6,0x5694DC,0x000008,0x000000,0x000000,0x0A1627,0x4A9CF0,0x183252,0x578ACA,0x194469,0x0F2437,0x538CD6,0x194469,0x3973B6,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x4A6790,0x4673AB,0x000008,0x191823,0x556B9C,0x457AB9,0x000000,0x5577A7,0x3D5881,0x264973,0x0F2437,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x66ABFD,0x194469,0x183252,0x000008,0x2C578B};
-  const long wa9[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0A1627,0x2C8596,0x1A98AC,0x4FA6B4,0x8797AC,0x9EA2A3,0x110808,0x000000,0x080808,0x000000,0x838188,0xCDD6CE,0xCDDDEA,0xFDFFFF,0xB5FFFF,0x56DAEC,0x3FCAE8,0x48BAF9,0x316398,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x4A95E8,0x57CAFE,0x88FEFF,0x67FEFF,0x67FEFF,0xADFFFF,0xEBFFFF,0xD9DBDB,0x000000,0x7B7575,0xEAECEB,0x9CDEF0,0x77FEFF,0x56FEFF,0x34F0FF,0x88EBFF,0xA5EFFF,0x94D6FF,0x346BA7,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0F2437,0x9CDEFF,0xA5E7FF,0xA5E7FF,0x478CD8,0x38BAE4,0x56FEFF,0x45FDFF,0x88FEFF,0xAADEE8,0xB9D6DA,0x77DAEB,0x88E7F5,0x67FEFF,0x88EBFF,0x67FEFF,0x48BAF9,0x559AEB,0x669CE5,0x9CD6FF,0x9DD6F7,0x94D6F6,0x030811,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x559AEB,0x4CACF6,0x96CBFF,0x4995DD,0xA5E7FF,0x68CAFE,0xADFFFF,0xB5FFFF,0x6FC9D6,0x56DBFD,0x2D6879,0x88EBFF,0xADFFFF,0xB5F7FF,0x68B7FF,0x68B7FF,0x94D6F6,0x84C6F2,0x84C6FF,0x478CD8,0x2C578B,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x061017,0x191823,0x8DB9C7,0x578ACA,0x538CD6,0x76BAFF,0x76A6E7,0x68B7FF,0x76BAFF,0x89D7FF,0x080808,0x000000,0x829DD0,0x264973,0x061017,0x69A5EF,0x76ADF8,0x0A1627,0x061017,0x5694DC,0x5694DC,0x183252,0x30425A,0x000000,0x000000,0x000000,0x000000,0x000000,0x66ABFD,0x535D67,0x000000,0x194469,0x316398,0x194469,0x183252,0x000000,0x000000,0x3D5881,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x69A5EF,0x5694DC,0x000008,0x000000,0x000000,0x000000,0x76BAFF,0x264973,0x6995D4,0x061017,0x0F2437,0x397BC0,0x0A1627,0x2C578B,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x556B9C,0x478CD8,0x194469,0x0A1627,0x8DB9C7,0x427BC6,0x000000,0x76A6E7,0x205380,0x194469,0x030811,0x000000,0x061017,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x69A5EF,0x0F2437,0x547BB7,0x000000,0x264973};
-  const long wa10[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x0A1627,0x167589,0x1A98AC,0x70B9C8,0x8797AC,0x9EA2A3,0x212121,0x080808,0x000000,0x000000,0x9EA2A3,0xD9DBDB,0xB9DEE5,0xFDFFFF,0xB5FFFF,0x56DAEC,0x30D8F4,0x48BAF9,0x0A1627,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x538CD6,0x56B9E7,0x67DAEC,0x67FEFF,0x67FEFF,0xA5FFFF,0xDAFFFF,0xDAE7EA,0x080808,0x8D8F93,0xDAE7EA,0x88DAE8,0x77FEFF,0x56FEFF,0x56EBFE,0xA0F7FF,0xADEFFF,0x94D6F6,0x2F65A3,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x0A1627,0x9CD6FF,0x9CDEFF,0xADE7FF,0x478CD8,0x45B9EA,0x67FEFF,0x45FDFF,0x88FEFF,0xAAE7EF,0xB9DEE5,0x88EBFF,0x88E7F5,0x67FEFF,0x34F0FF,0x67EBFE,0x57CAFE,0x538CD6,0x669CE5,0x9CD6FF,0x8DCEF0,0x90C6F6,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x4673AB,0x69A5EF,0x96CBFF,0x4484CC,0x92DEFF,0x68CAFE,0x88FEFF,0x98FEFF,0x70B9C8,0x77EBFE,0x8797AC,0xA5FFFF,0x98FEFF,0x92DEFF,0x68B7FF,0x68B7FF,0x84C6FF,0x90C6F6,0x84C6FF,0x547BB7,0x2F65A3,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x191823,0x000000,0x8DCEF0,0x5694DC,0x457AB9,0x76BAFF,0x76A6E7,0x86BBFE,0x96ADF7,0x8CCEFF,0x080808,0x000000,0x3D5881,0x000000,0x0F2437,0x4A9CF0,0x86BBFE,0x000000,0x3A3949,0x97B8E9,0x66ABFD,0x6B8DB7,0x183252,0x000000,0x000000,0x000000,0x000000,0x030811,0x86ABE7,0x131314,0x000000,0x2C578B,0x194469,0x194469,0x264973,0x000000,0x000000,0x4A6790,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x080808,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x6B8DB7,0x4A95E8,0x0F2437,0x000000,0x000000,0x30425A,0x76ADF8,0x205380,0x578ACA,0x000808,0x0A1627,0x264973,0x194469,0x183252,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x556B9C,0x538CD6,0x556B9C,0x2F65A3,0xAADEE8,0x4484CC,0x0A1627,0x77B8EC,0x316398,0x183252,0x000000,0x000000,0x667DA8,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x4A6790,0x080808,0x6995D4,0x000000,0x183252};
-
-
 void ghost(CRGB* leds) {
-  const long ghost1[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0x000000,0x000000,0x000000,0x000000,0x2121FF,0x2121FF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x2121FF,0x2121FF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0x2121FF,0x2121FF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0x2121FF,0x2121FF,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000};
-  const long ghost2[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0x000000,0x000000,0x000000,0x000000,0x2121FF,0x2121FF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x2121FF,0x2121FF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0x2121FF,0x2121FF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0x2121FF,0x2121FF,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000};
-  const long ghost3[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0x2121FF,0x2121FF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0x2121FF,0x2121FF,0x000000,0x000000,0x000000,0xFF0000,0x2121FF,0x2121FF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x2121FF,0x2121FF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000};
-  const long ghost4[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x2121FF,0x2121FF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x2121FF,0x2121FF,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xDEDEFF,0x2121FF,0x2121FF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0x2121FF,0x2121FF,0xDEDEFF,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000};
-  const long ghost5[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xDEDEFF,0x2121FF,0x2121FF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0x2121FF,0x2121FF,0xDEDEFF,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0x2121FF,0x2121FF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x2121FF,0x2121FF,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000};
-  const long ghost6[] PROGMEM = {0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x2121FF,0x2121FF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x2121FF,0x2121FF,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0xDEDEFF,0x2121FF,0x2121FF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0x2121FF,0x2121FF,0xDEDEFF,0x000000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xDEDEFF,0xFF0000,0x000000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xDEDEFF,0xDEDEFF,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0xFF0000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0xFF0000,0xFF0000,0x000000,0x000000,0x000000,0xFF0000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000,0x000000};
-
-  long replaceColor = 0xFF0000;
-  EVERY_N_SECONDS( 5 )  { ghostcolor = random(4);}
-  switch(ghostcolor) {
-    case 0:
-      replaceColor = 0xFF0000; break;  //red
-    case 1:
-      replaceColor = 0xffb7ff;break;   //pinky
-    case 3:
-      replaceColor = 0x1717c0;break;   // blue
-    case 4:
-      replaceColor = 0xffb751;break;   //orange 
-  }
-  int randomNumber = random(3);
-  switch(randomNumber) { // look in a random direction
-    case 0:
-        loadArray(ghost3,leds,0xFF0000,replaceColor); nap(900);
-        break;
-    case 1:
-        loadArray(ghost4,leds,0xFF0000,replaceColor); nap(900);
-        break;
-    case 2:
-        loadArray(ghost5,leds,0xFF0000,replaceColor); nap(900);
-        break;
-    case 3:
-        loadArray(ghost6,leds,0xFF0000,replaceColor); nap(900);
-        break;
-    default:
-        break;
-  }
-  for(int i = 0; i < 5; i++) { // walking ghost
-      loadArray(ghost1,leds,0xFF0000,replaceColor); nap(500);
-      loadArray(ghost2,leds,0xFF0000,replaceColor); nap(500);
+  // Sheet frames: 0-1 walking, 2-5 looking around.
+  // One cycle is a look in a random direction followed by 5 steps of
+  // walking (10 frames). Color only changes at the start of a cycle.
+  static uint8_t step = 0;
+  static long replaceColor = 0xFF0000;
+
+  if (step == 0) {
+    EVERY_N_SECONDS( 5 )  { ghostcolor = random(4);}
+    switch(ghostcolor) {
+      case 0:
+        replaceColor = 0xFF0000; break;  //red
+      case 1:
+        replaceColor = 0xffb7ff;break;   //pinky
+      case 3:
+        replaceColor = 0x1717c0;break;   // blue
+      case 4:
+        replaceColor = 0xffb751;break;   //orange 
+    }
+    int randomNumber = random(3); // look in a random direction
+    setFrameDelay(spriteDrawFrame(ghostSheet, 2 + randomNumber, leds, 0, 0, 0xFF0000, replaceColor));
+  } else { // walking ghost
+    setFrameDelay(spriteDrawFrame(ghostSheet, (step & 1) ? 0 : 1, leds, 0, 0, 0xFF0000, replaceColor));
   }
-
-
-}
\ No newline at end of file
+  step = (step + 1) % 11;
+}
@@ -1,6 +1,7 @@
 #include <patterns.h>
 #include <led_display.h>
 #include "config.h"  // Include global configuration
+#include <fixmath.h>
 
 // Include complex patterns with UI components
 #include "draw/draw.h"
@@ -9,6 +10,8 @@
 #include "snake/snake.h"
 #include "tetris/tetris.h"
 #include "clock/clock.h"  // Add new clock pattern header
+#include "animation/animation.h"
+#include "SPIFFS.h"
 #if ENABLE_MICROPHONE
 #include "audio/audio.h"  // Add audio pattern header
 #endif
@@ -21,10 +24,16 @@
 
 // Forward declarations of all pattern functions
 void pac(CRGB* leds);
+void pacBegin();
 void qbert(CRGB* leds);
+void qbertBegin();
 void mario(CRGB* leds);
+void marioBegin();
 void ghost(CRGB* leds);
 void water(CRGB* leds);
+void waterBegin();
+void waterEnd();
+size_t waterStateSize();
 void rainbow(CRGB* leds);
 void rainbowWithGlitter(CRGB* leds);
 void pulse(CRGB* leds);
@@ -34,31 +43,43 @@ void bpm(CRGB* leds);
 void watermatrix(CRGB* leds);
 void juggle(CRGB* leds); 
 void firefunction(CRGB* leds);
+void fireBegin();
+void fireEnd();
+size_t fireStateSize();
 void greenBlackLoop(CRGB* leds);
+void matrixBegin();
 void explode(CRGB* leds);
 void sleepLED(CRGB* leds);
 void swirl(CRGB* leds);
 void meteorRain(CRGB* leds);
+void lifeBegin();
+void lifeEnd();
+size_t lifeStateSize();
 void colorWipe(CRGB* leds);
 void clockCountdown(CRGB* leds);  // Keep declaration
 void dvdBounce(CRGB* leds);
 void beachBall(CRGB* leds);
 void randomPattern(CRGB* leds);
+void randomEnd();
+size_t randomStateSize();
 void sparkler(CRGB* leds);  // New sparkler pattern
+void sparklerBegin();
+void sparklerEnd();
+size_t sparklerStateSize();
 
 // Provide the actual array definition
 Pattern g_patternList[] = {
 #if ENABLE_MICROPHONE
-    { "Audio Test",        audio,             "🎤" },  // Add audio pattern only if microphone enabled
+    { "Audio Test",        audio,             "🎤", audioBegin, audioEnd, audioStateSize },  // Add audio pattern only if microphone enabled
 #endif
-    { "Fire",              firefunction,      "🔥" },
-    { "The Matrix",        greenBlackLoop,    "🧮" },
+    { "Fire",              firefunction,      "🔥", fireBegin, fireEnd, fireStateSize },
+    { "The Matrix",        greenBlackLoop,    "🧮", matrixBegin },
     { "Pac Man Ghost",     ghost,             "👻" },
-    { "Qbert",             qbert,             "🎲" },
+    { "Qbert",             qbert,             "🎲", qbertBegin },
     { "DVD Bounce",        dvdBounce,         "📀" },
-    { "Ms Pac-Man",        pac,               "🎮" },
-    { "Jelly Fish",        water,             "🪼" },
-    { "Super Mario",       mario,             "🍄" },
+    { "Ms Pac-Man",        pac,               "🎮", pacBegin },
+    { "Jelly Fish",        water,             "🪼", waterBegin, waterEnd, waterStateSize },
+    { "Super Mario",       mario,             "🍄", marioBegin },
     { "Rainbow Drift",     rainbow,           "🌈" },
     { "Pixel Swaps",       watermatrix,       "🔀" },
     { "Rainbow Glitter",   rainbowWithGlitter,"✨" },
@@ -68,17 +89,18 @@ Pattern g_patternList[] = {
     { "Twinkle",           twinkle,           "⭐" },
     { "Sleep Device",      sleepLED,          "💤" },
     { "Swirl",             swirl,             "🌀" },
-    { "Game of Life",      meteorRain,        "🦠" },
+    { "Game of Life",      meteorRain,        "🦠", lifeBegin, lifeEnd, lifeStateSize },
     { "Color Wipe",        colorWipe,         "🧹" },
     { "Beach Ball",        beachBall,         "🏐" },
     { "Clock Countdown",   clockCountdown,    "⏳" },
     { "Draw",              draw,              "🖌️" },
     { "Video",             video,             "🎬" },
     { "Type",              type,              "⌨️" },
-    { "Random",            randomPattern,     "🎲" },
-    { "Snake Game",        snake,             "🐍" },
-    { "Tetris Game",       tetris,            "🧩" },
-    { "Sparkler",          sparkler,          "💫" }
+    { "Random",            randomPattern,     "🎲", nullptr, randomEnd, randomStateSize },
+    { "Snake Game",        snake,             "🐍", snakeBegin },
+    { "Tetris Game",       tetris,            "🧩", tetrisBegin },
+    { "Sparkler",          sparkler,          "💫", sparklerBegin, sparklerEnd, sparklerStateSize },
+    { "Animation",         animation,         "🎞️", animationBegin, animationEnd, animationStateSize }
 };
 
 // And the size of that array
@@ -91,63 +113,80 @@ extern int g_Speed;
 extern uint8_t g_hue; // rotating "base color" used by many of the patterns
 
 
-void nap(int wait){
-   float Delay;
-   Delay = (2000/g_Speed)+wait; 
-   FastLED.delay(Delay);
+uint16_t g_frameDelay = 0;
+
+void setFrameDelay(int wait){
+   // Speed 0 is allowed by the slider, avoid dividing by it
+   g_frameDelay = (2000/max(g_Speed, 1))+wait;
+}
+
+// Web handlers call this after changing what a pattern draws, so the
+// change shows up without waiting out the pattern's frame delay
+volatile bool g_frameRequested = false;
+void requestFrame(){
+   g_frameRequested = true;
+   if (g_renderTask) {
+      xTaskNotifyGive(g_renderTask);
+   }
+}
+
+void beginPattern(size_t index) {
+   if (index < PATTERN_COUNT && g_patternList[index].begin) {
+      g_patternList[index].begin();
+   }
+}
+
+void endPattern(size_t index) {
+   if (index < PATTERN_COUNT && g_patternList[index].end) {
+      g_patternList[index].end();
+   }
+}
+
+size_t patternStateSize(size_t index) {
+   if (index < PATTERN_COUNT && g_patternList[index].stateSize) {
+      return g_patternList[index].stateSize();
+   }
+   return 0;
 }
 
 void sleepLED(CRGB* leds) {
-    static bool initialized = false;
-    static unsigned long lastUpdate = 0;
-    static unsigned long lastCall = 0;
-    const unsigned long UPDATE_INTERVAL = 60000; // Only update every minute
-    const unsigned long TIMEOUT_INTERVAL = 2000; // Reset initialization if not called for 2 seconds
-    
-    unsigned long currentMillis = millis();
-    
-    // Check if we haven't been called in a while (meaning we switched patterns)
-    if (currentMillis - lastCall > TIMEOUT_INTERVAL) {
-        initialized = false;
-    }
-    lastCall = currentMillis;
-    
-    // Initial setup when entering sleep mode
-    if (!initialized) {
-        fill_solid(leds, NUM_LEDS, CRGB::Black);    
-        FastLED.setBrightness(0);
-        FastLED.show();
-        initialized = true;
-        lastUpdate = currentMillis;
-        return;
-    }
-    
-    // Only update the display periodically to maintain deep sleep state
-    if (currentMillis - lastUpdate >= UPDATE_INTERVAL) {
-        // Quick check to ensure LEDs are still off
-        // This helps recover from any potential glitches
-        FastLED.setBrightness(0);
-        FastLED.show();
-        lastUpdate = currentMillis;
-    }
-    
-    // Small delay to reduce CPU usage while still being responsive
-    delay(500);
+    // Keep the LEDs dark. The scheduler starts us on the very next frame
+    // after a switch, so there is no need to detect entering sleep mode.
+    fill_solid(leds, NUM_LEDS, CRGB::Black);
+
+    // Nothing changes while asleep, so only wake up twice a second
+    setFrameDelay(500);
+}
+
+
+// The water loop is by far the biggest sheet, so it is streamed from SPIFFS
+// (data/sprites) and only the frame on screen is held in RAM
+#define WATER_SHEET_PATH "/sprites/waterSheet.pxs"
+static SpriteStream s_waterStream;
+
+void waterBegin() {
+  if (!spriteStreamOpen(&s_waterStream, SPIFFS, WATER_SHEET_PATH)) {
+    Serial.println("Jelly Fish: can't open " WATER_SHEET_PATH ", was the filesystem uploaded?");
+  }
+}
+
+void waterEnd() {
+  spriteStreamClose(&s_waterStream);
 }
 
+size_t waterStateSize() {
+  return spriteStreamMemory(&s_waterStream);
+}
 
 void water(CRGB* leds) {
-  loadArray(wa1,leds); nap(50);
-  loadArray(wa2,leds); nap(50);
-  loadArray(wa3,leds); nap(50);
-  loadArray(wa4,leds); nap(50);
-  loadArray(wa5,leds), nap(50);
-  loadArray(wa6,leds); nap(50);
-  loadArray(wa7,leds); nap(50);
-  loadArray(wa8,leds); nap(50);
-  loadArray(wa9,leds); nap(50);
-  loadArray(wa10,leds); nap(50);
- }
+  uint16_t duration = spriteStreamNext(&s_waterStream, leds);
+  if (duration == 0) {
+    fill_solid(leds, NUM_LEDS, CRGB::Black);
+    setFrameDelay(500);
+    return;
+  }
+  setFrameDelay(duration);
+}
 void rainbow(CRGB* leds) 
 {
   // FastLED's built-in rainbow generator
@@ -203,73 +242,102 @@ void bpm(CRGB* leds)
 }
 
 
+// Fire keeps a heat value per cell (column-major, one column after
+// another), allocated only while the pattern runs
+static uint8_t* s_fireHeat = nullptr;
+
+void fireBegin() {
+  s_fireHeat = (uint8_t*)calloc(NUM_LEDS, 1);
+}
+
+void fireEnd() {
+  free(s_fireHeat);
+  s_fireHeat = nullptr;
+}
+
+size_t fireStateSize() {
+  return s_fireHeat ? NUM_LEDS : 0;
+}
+
 void firefunction(CRGB* leds)
 {
-  const uint8_t cols = 16;
-  const uint8_t rows = 16;
+  const uint16_t cols = LED_WIDTH;
+  const uint16_t rows = LED_HEIGHT;
 
   uint8_t cooling = 25;
-  static uint8_t heat[cols][rows];
-  nap(20);
+  setFrameDelay(20);
+  if (!s_fireHeat) return;
+  uint8_t* heat = s_fireHeat;
+  #define HEAT(i, j) heat[(i) * rows + (j)]
+
   // Step 1. Cool down every cell a little
   for (int i = 0; i < cols; i++) {
     for (int j = 0; j < rows; j++) {
-      heat[i][j] = qsub8(heat[i][j], random8(0, ((cooling * 10) / rows) + 2));
+      HEAT(i, j) = qsub8(HEAT(i, j), random8(0, ((cooling * 10) / rows) + 2));
     }
   }
 
   // Step 2. Heat from each cell drifts 'up' and diffuses a little
   for (int j = 0; j < rows - 1; j++) {
     for (int i = 0; i < cols; i++) {
-      heat[i][j] = (heat[i][j + 1] + heat[(i + 1) % cols][j +1] + heat[(i + cols - 1) % cols][j + 1] + heat[i][j + 1]) / 4;
+      HEAT(i, j) = (HEAT(i, j + 1) + HEAT((i + 1) % cols, j + 1) + HEAT((i + cols - 1) % cols, j + 1) + HEAT(i, j + 1)) / 4;
     }
   }
 
-  // Step 3. Randomly ignite new 'sparks' of heat near the bottom
-  if (random8() < 90) {
-    int sparkX = random8(cols);
-    heat[sparkX][rows - 1] = qadd8(heat[sparkX][rows - 1], random8(160, 200));
+  // Step 3. Randomly ignite new 'sparks' of heat near the bottom, about
+  // as many per column as on a single 16 wide panel
+  for (int n = 0; n < (cols + 15) / 16; n++) {
+    if (random8() < 90) {
+      int sparkX = random16(cols);
+      HEAT(sparkX, rows - 1) = qadd8(HEAT(sparkX, rows - 1), random8(160, 200));
+    }
   }
 
   // Step 4. Map from heat cells to LED colors
   for (int i = 0; i < cols; i++) {
     for (int j = 0; j < rows; j++) {
-      int colorindex = scale8(heat[i][j], 240);
+      int colorindex = scale8(HEAT(i, j), 240);
       leds[XY(i, j)] = ColorFromPalette(HeatColors_p, colorindex);
     }
   }
+  #undef HEAT
 }
 
 
 // Define a structure to represent a falling dot
 struct FallingDot {
-  int8_t col; // Current column
-  int8_t row; // Current row
+  int16_t col; // Current column
+  int16_t row; // Current row
   uint8_t speed; // Speed of the dot (1 to 5)
   uint8_t counter; // Frame counter for animation
   bool active; // Whether the dot is active or not
   uint8_t brightness; 
 };
 
-void greenBlackLoop(CRGB* leds) {
-  const uint8_t cols = 16;
-  const uint8_t rows = 16;
-  const uint8_t numDots = 10; // Number of falling dots
-  static FallingDot dots[numDots];
-  static bool isInitialized = false;
-
-  // Initialize the falling dots with random starting positions and speeds
-  if (!isInitialized) {
-    for (int i = 0; i < numDots; i++) {
-      dots[i].col = random(cols);
-      dots[i].row = random(rows);
-      dots[i].speed = random(1, 6); // Random speed from 1 to 5
-      dots[i].counter = 0;
-      dots[i].brightness = random(10, 256); 
-      dots[i].active = true;
-    }
-    isInitialized = true;
+// 10 falling dots per 16x16 panel's worth of display
+static const uint8_t kMaxMatrixDots = LED_MAX_LEDS * 10 / 256;
+static FallingDot s_matrixDots[kMaxMatrixDots];
+static uint8_t s_matrixDotCount = 0;
+
+// Start the falling dots at random positions and speeds
+void matrixBegin() {
+  s_matrixDotCount = max(1, NUM_LEDS * 10 / 256);
+  for (int i = 0; i < s_matrixDotCount; i++) {
+    s_matrixDots[i].col = random(LED_WIDTH);
+    s_matrixDots[i].row = random(LED_HEIGHT);
+    s_matrixDots[i].speed = random(1, 6); // Random speed from 1 to 5
+    s_matrixDots[i].counter = 0;
+    s_matrixDots[i].brightness = random(10, 256); 
+    s_matrixDots[i].active = true;
   }
+}
+
+void greenBlackLoop(CRGB* leds) {
+  const uint16_t cols = LED_WIDTH;
+  const uint16_t rows = LED_HEIGHT;
+  const uint8_t numDots = s_matrixDotCount;
+  FallingDot* dots = s_matrixDots;
+
   fadeToBlackBy(leds, NUM_LEDS, 80);
 
     // Update the position of each dot and render it
@@ -314,9 +382,7 @@ void greenBlackLoop(CRGB* leds) {
       leds[XY(dots[inactiveDotIndex].col, dots[inactiveDotIndex].row)] = CRGB::Green;
     }
 
-    // Update the display
-    FastLED.show();
-    nap(5); // Adjust this delay to control the speed of the animation
+    setFrameDelay(5); // Adjust this delay to control the speed of the animation
   }
 
 
@@ -349,10 +415,15 @@ void swirl(CRGB* leds) {
   static uint16_t angle = 0;          // Controls rotation over time
   static uint8_t hueOffset = 0;       // Controls color cycling
   
-  const uint8_t centerX = 8;          // Center X (for 16x16 matrix)
-  const uint8_t centerY = 8;
+  const int centerX = LED_WIDTH / 2;
+  const int centerY = LED_HEIGHT / 2;
   const uint8_t numArms = 3;          // Number of spiral arms
-  const float spiralTightness = 0.7;  // Controls how tight the spiral is
+  // Arm length, 12 on a 16x16 panel, and how far an arm turns per pixel
+  // of radius (0.7 * 30 degrees)
+  const fix16 reach = fix16FromInt(max(LED_WIDTH, LED_HEIGHT)) * 3 / 4;
+  const fix16 twist = fix16FromFloat(21 * 65536.0 / 360);
+  const fix16 radiusStep = FIX16_ONE / 4;
+  const fix16 fadeStep = fix16Div(radiusStep, reach);  // radius / reach per step
   
   // Clear the display
   fill_solid(leds, NUM_LEDS, CRGB::Black);
@@ -363,21 +434,23 @@ void swirl(CRGB* leds) {
   
   // Draw multiple spiral arms
   for (uint8_t arm = 0; arm < numArms; arm++) {
-    float armOffset = (360.0 / numArms) * arm;
+    uint16_t armAngle = angleFromDegrees(angle + (360 / numArms) * arm);
+    fix16 fade = 0;
     
     // Draw each spiral arm
-    for (float radius = 0; radius < 12; radius += 0.25) {
+    for (fix16 radius = 0; radius < reach; radius += radiusStep, fade += fadeStep) {
       // Calculate spiral position
-      float spiralAngle = (angle + armOffset + (radius * spiralTightness * 30)) * (PI / 180.0);
-      int x = centerX + (radius * cos(spiralAngle));
-      int y = centerY + (radius * sin(spiralAngle));
+      uint16_t spiralAngle = armAngle + fix16ToInt(fix16Mul(radius, twist));
+      Fix16Vec p = fix16Polar(spiralAngle, radius);
+      int x = centerX + fix16ToInt(p.x);
+      int y = centerY + fix16ToInt(p.y);
       
       // Only draw if within bounds
-      if (x >= 0 && x < 16 && y >= 0 && y < 16) {
+      if (x >= 0 && x < LED_WIDTH && y >= 0 && y < LED_HEIGHT) {
         // Calculate color based on radius and arm
-        uint8_t hue = hueOffset + (radius * 12) + (arm * 85);
+        uint8_t hue = hueOffset + fix16ToInt(fade * 144) + (arm * 85);
         uint8_t sat = 255;
-        uint8_t val = 255 - (radius * 10); // Fade brightness toward the end
+        uint8_t val = 255 - fix16ToInt(fade * 120); // Fade brightness toward the end
         
         // Draw the pixel with a slight glow effect
         leds[XY(x, y)] = CHSV(hue, sat, val);
@@ -388,7 +461,7 @@ void swirl(CRGB* leds) {
             if (dx == 0 && dy == 0) continue;
             int glowX = x + dx;
             int glowY = y + dy;
-            if (glowX >= 0 && glowX < 16 && glowY >= 0 && glowY < 16) {
+            if (glowX >= 0 && glowX < LED_WIDTH && glowY >= 0 && glowY < LED_HEIGHT) {
               leds[XY(glowX, glowY)] += CHSV(hue, sat, val / 4);
             }
           }
@@ -397,104 +470,186 @@ void swirl(CRGB* leds) {
     }
   }
   
-  FastLED.show();
-  nap(20); // Adjust delay to control animation speed
+  setFrameDelay(20); // Adjust delay to control animation speed
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 // Game of Life (replacing "meteorRain")
-// Standard Conway's rules, on a 16x16 matrix
+// Standard Conway's rules, on the whole display
 ///////////////////////////////////////////////////////////////////////////
-void meteorRain(CRGB* leds) {
-  // In this version, 'meteorRain' is replaced by 'Game of Life' logic.
-  // Now with a reset every 60 seconds.
-
-  static bool initialized = false;
-  static bool board[16][16];
-  static bool nextBoard[16][16];
-
-  // Initialize board randomly once
-  if(!initialized) {
-    initialized = true;
-    for(uint8_t y = 0; y < 16; y++){
-      for(uint8_t x = 0; x < 16; x++){
-        // ~1/3 chance alive
-        board[y][x] = (random8() < 85); 
+#define LIFE_HISTORY     16   // generations remembered to spot short cycles
+#define LIFE_STALE_HOLD  8    // generations a dead or cycling board stays up
+#define LIFE_STAGNANT    50   // generations of steady population before a reseed
+
+// The board is bit-packed (see lifeStep() in patterns.h), so a row of up
+// to 32 cells is a single word. A generation is computed a word at a
+// time: the eight neighbor rows (the three above and below, shifted left
+// and right, and the two beside) are added bitwise with full adders, so
+// 32 cells are counted at once.
+struct LifeState {
+  uint16_t words;        // per row
+  uint32_t* board;       // current generation, LED_HEIGHT rows
+  uint32_t* next;
+  uint32_t history[LIFE_HISTORY];  // hashes of recent generations
+  uint8_t historyPos;
+  uint16_t population;
+  uint16_t steadyGens;   // generations the population hasn't changed
+  uint8_t staleGens;     // generations since the board died or started cycling
+};
+static LifeState* s_life = nullptr;
+
+static void seedLife() {
+  LifeState& s = *s_life;
+  memset(s.board, 0, LED_HEIGHT * s.words * sizeof(uint32_t));
+  for (uint16_t y = 0; y < LED_HEIGHT; y++) {
+    for (uint16_t x = 0; x < LED_WIDTH; x++) {
+      // ~1/3 chance alive
+      if (random8() < 85) {
+        s.board[y * s.words + x / 32] |= 1u << (x % 32);
       }
     }
   }
+  memset(s.history, 0, sizeof(s.history));
+  s.population = 0;
+  s.steadyGens = 0;
+  s.staleGens = 0;
+}
 
-  // Clear nextBoard before computing next generation
-  for(uint8_t y = 0; y < 16; y++){
-    for(uint8_t x = 0; x < 16; x++){
-      nextBoard[y][x] = false;
-    }
-  }
+void lifeBegin() {
+  uint16_t words = (LED_WIDTH + 31) / 32;
+  size_t boardBytes = LED_HEIGHT * words * sizeof(uint32_t);
+  s_life = (LifeState*)calloc(1, sizeof(LifeState) + 2 * boardBytes);
+  if (!s_life) return;
+  s_life->words = words;
+  s_life->board = (uint32_t*)(s_life + 1);
+  s_life->next = s_life->board + LED_HEIGHT * words;
+  seedLife();
+}
 
-  // Compute the next generation using Conway's rules
-  for(uint8_t y = 0; y < 16; y++){
-    for(uint8_t x = 0; x < 16; x++){
-      // Count the 8 neighbors
-      uint8_t neighbors = 0;
-      for(int8_t dy = -1; dy <= 1; dy++){
-        for(int8_t dx = -1; dx <= 1; dx++){
-          if(dx == 0 && dy == 0) continue; // skip self
-          int8_t nx = x + dx;
-          int8_t ny = y + dy;
-          // Skips out-of-bounds cells
-          if(nx >= 0 && nx < 16 && ny >= 0 && ny < 16){
-            if(board[ny][nx]) {
-              neighbors++;
-            }
-          }
-        }
-      }
+void lifeEnd() {
+  free(s_life);
+  s_life = nullptr;
+}
 
-      // Apply Conway's rules:
-      bool alive = board[y][x];
-      if(alive && (neighbors == 2 || neighbors == 3)) {
-        nextBoard[y][x] = true;
-      } else if(!alive && (neighbors == 3)) {
-        nextBoard[y][x] = true;
-      } else {
-        nextBoard[y][x] = false;
+size_t lifeStateSize() {
+  return s_life ? sizeof(LifeState) + 2 * LED_HEIGHT * s_life->words * sizeof(uint32_t) : 0;
+}
+
+// Bitwise adders: each bit position is a separate sum
+static inline void lifeFullAdd(uint32_t a, uint32_t b, uint32_t c, uint32_t& sum, uint32_t& carry) {
+  uint32_t t = a ^ b;
+  sum = t ^ c;
+  carry = (a & b) | (t & c);
+}
+
+// Row `row` shifted so each bit holds its left (west) or right (east)
+// neighbor. `wrapBit` is the cell brought in from the far edge.
+static inline uint32_t lifeWest(const uint32_t* row, uint16_t w, uint32_t wrapBit) {
+  return (row[w] << 1) | (w > 0 ? row[w - 1] >> 31 : wrapBit);
+}
+
+static inline uint32_t lifeEast(const uint32_t* row, uint16_t w, uint16_t words, uint8_t lastBit, uint32_t wrapBit) {
+  return (row[w] >> 1) | (w + 1 < words ? row[w + 1] << 31 : wrapBit << lastBit);
+}
+
+uint16_t lifeStep(const uint32_t* board, uint32_t* next, uint16_t width, uint16_t height) {
+  const uint16_t words = (width + 31) / 32;
+  const uint8_t lastBit = (width - 1) % 32;                 // column width - 1 in the last word
+  const uint32_t lastMask = lastBit == 31 ? ~0u : (2u << lastBit) - 1;
+  static const uint32_t empty[LED_MAX_LEDS / 32 + 1] = {0};
+  uint16_t population = 0;
+
+  for (uint16_t y = 0; y < height; y++) {
+    const uint32_t* rows[3] = {
+      y > 0 ? board + (y - 1) * words : (LIFE_WRAP ? board + (height - 1) * words : empty),
+      board + y * words,
+      y + 1 < height ? board + (y + 1) * words : (LIFE_WRAP ? board : empty),
+    };
+    uint32_t* out = next + y * words;
+
+    for (uint16_t w = 0; w < words; w++) {
+      uint32_t west[3], east[3];
+      for (uint8_t r = 0; r < 3; r++) {
+        // Cells off the edge: the opposite column when wrapping, else dead
+        uint32_t firstCell = LIFE_WRAP ? rows[r][0] & 1 : 0;
+        uint32_t lastCell = LIFE_WRAP ? (rows[r][words - 1] >> lastBit) & 1 : 0;
+        west[r] = lifeWest(rows[r], w, lastCell);
+        east[r] = lifeEast(rows[r], w, words, lastBit, firstCell);
+      }
+      uint32_t alive = rows[1][w];
+
+      // Add up the eight neighbors: ones from each group of three, then
+      // the twos. A cell is born with 3 and survives with 2 or 3, i.e.
+      // exactly one two plus a one or the cell itself.
+      uint32_t above0, above1, below0, below1, ones, carry, twos0, twos1;
+      lifeFullAdd(west[0], rows[0][w], east[0], above0, above1);
+      lifeFullAdd(west[2], rows[2][w], east[2], below0, below1);
+      uint32_t side0 = west[1] ^ east[1], side1 = west[1] & east[1];
+      lifeFullAdd(above0, below0, side0, ones, carry);
+      lifeFullAdd(above1, below1, side1, twos0, twos1);
+      uint32_t oneTwo = (twos0 ^ carry) & ~twos1;
+
+      uint32_t cells = oneTwo & (ones | alive);
+      if (w == words - 1) {
+        cells &= lastMask;
       }
+      out[w] = cells;
+      population += __builtin_popcount(cells);
     }
   }
+  return population;
+}
+
+// FNV-1a over the board's words
+static uint32_t lifeHash(const LifeState& s) {
+  uint32_t hash = 2166136261u;
+  for (uint16_t i = 0; i < LED_HEIGHT * s.words; i++) {
+    hash = (hash ^ s.board[i]) * 16777619u;
+  }
+  return hash;
+}
 
-  // Copy nextBoard into board
-  for(uint8_t y = 0; y < 16; y++){
-    for(uint8_t x = 0; x < 16; x++){
-      board[y][x] = nextBoard[y][x];
+void meteorRain(CRGB* leds) {
+  // In this version, 'meteorRain' is replaced by 'Game of Life' logic.
+
+  if (!s_life) return;
+  LifeState& s = *s_life;
+
+  // A board that died, settled or fell into a short cycle is left up for
+  // a few generations and then reseeded. Long cycles such as a glider
+  // circling the torus are caught by the population holding steady.
+  if (s.staleGens >= LIFE_STALE_HOLD || s.steadyGens >= LIFE_STAGNANT) {
+    seedLife();
+  } else {
+    uint16_t population = lifeStep(s.board, s.next, LED_WIDTH, LED_HEIGHT);
+    uint32_t* previous = s.board;
+    s.board = s.next;
+    s.next = previous;
+
+    uint32_t hash = lifeHash(s);
+    bool repeated = false;
+    for (uint8_t i = 0; i < LIFE_HISTORY; i++) {
+      repeated |= s.history[i] == hash;
     }
+    s.history[s.historyPos] = hash;
+    s.historyPos = (s.historyPos + 1) % LIFE_HISTORY;
+
+    s.staleGens = population == 0 || repeated || s.staleGens > 0 ? s.staleGens + 1 : 0;
+    s.steadyGens = population == s.population ? s.steadyGens + 1 : 0;
+    s.population = population;
   }
 
   // Display: alive cells = White, dead cells = Black
-  for(uint8_t y = 0; y < 16; y++){
-    for(uint8_t x = 0; x < 16; x++){
-      if(board[y][x]) {
-        leds[ XY(x, y) ] = CRGB::White;
-      } else {
-        leds[ XY(x, y) ] = CRGB::Black;
-      }
+  for (uint16_t y = 0; y < LED_HEIGHT; y++) {
+    const uint32_t* row = s.board + y * s.words;
+    for (uint16_t x = 0; x < LED_WIDTH; x++) {
+      leds[XY(x, y)] = (row[x / 32] >> (x % 32)) & 1 ? CRGB::White : CRGB::Black;
     }
   }
 
-  FastLED.show();
-
   // Delay between generations
-  nap(600);
-
-  // --- RESET AFTER 60 SECONDS ---
-  EVERY_N_SECONDS(30) {
-    // Randomize the board again
-    for(uint8_t y = 0; y < 16; y++){
-      for(uint8_t x = 0; x < 16; x++){
-        board[y][x] = (random8() < 85); 
-      }
-    }
-  }
+  setFrameDelay(600);
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -502,24 +657,30 @@ void meteorRain(CRGB* leds) {
 //    Creates a continuous diagonal wipe effect that smoothly transitions colors
 ///////////////////////////////////////////////////////////////////////////
 void colorWipe(CRGB* leds) {
-  static int16_t wipePos = -16;  // Position of the wipe line
+  static int16_t wipePos = -LED_WIDTH;  // Position of the wipe line
   static bool rightToLeft = false;  // Direction of the wipe
   static CRGB currentColor = CHSV(random8(), 255, 255);  // Current color
   static CRGB nextColor = CHSV(random8(), 255, 255);     // Next color to transition to
   
+  // The transition zone is 4 pixels wide, so blend its colors once per
+  // frame with FastLED's blend rather than once per pixel
+  CRGB ramp[5];
+  for (uint8_t d = 1; d <= 4; d++) {
+    ramp[d] = blend(currentColor, nextColor, 255 - d * 255 / 4);
+  }
+  
   // Draw diagonal wipe
-  for (uint8_t x = 0; x < 16; x++) {
-    for (uint8_t y = 0; y < 16; y++) {
+  for (uint16_t x = 0; x < LED_WIDTH; x++) {
+    for (uint16_t y = 0; y < LED_HEIGHT; y++) {
       // Calculate position relative to the wipe line
-      int16_t pos = rightToLeft ? (15 - x + y) : (x + y);
+      int16_t pos = rightToLeft ? (LED_WIDTH - 1 - x + y) : (x + y);
       
       // Create smooth transition between colors
-      if (pos <= wipePos) {
+      int16_t distance = pos - wipePos;
+      if (distance <= 0) {
         leds[XY(x, y)] = nextColor;
-      } else if (pos <= wipePos + 4) {
-        // Blend between colors in the transition zone using FastLED's blend
-        uint8_t blendAmt = map(pos - wipePos, 0, 4, 255, 0);
-        leds[XY(x, y)] = blend(currentColor, nextColor, blendAmt);
+      } else if (distance <= 4) {
+        leds[XY(x, y)] = ramp[distance];
       }
     }
   }
@@ -528,15 +689,14 @@ void colorWipe(CRGB* leds) {
   wipePos++;
   
   // Check if wipe is complete
-  if (wipePos >= 30) {  // 30 gives enough room to complete the diagonal
-    wipePos = -16;  // Reset position
+  if (wipePos >= LED_WIDTH + LED_HEIGHT - 2) {  // the far corner has been covered
+    wipePos = -LED_WIDTH;  // Reset position
     rightToLeft = !rightToLeft;  // Change direction
     currentColor = nextColor;  // Current color becomes the one we just used
     nextColor = CHSV(random8(), 255, 255);  // Pick new color for next wipe
   }
   
-  FastLED.show();
-  nap(30);  // Control wipe speed
+  setFrameDelay(30);  // Control wipe speed
 }
 
 // Helper function to blend between two colors
@@ -549,9 +709,23 @@ CRGB blend_CRGB(CRGB color1, CRGB color2, uint8_t blend) {
 }
 
 // Random pattern that changes every 1 minute
+// Sub-pattern picked by randomPattern, -1 until the first pick
+static int s_randomCurrent = -1;
+
+void randomEnd() {
+  if (s_randomCurrent >= 0) {
+    endPattern(s_randomCurrent);
+    s_randomCurrent = -1;
+  }
+}
+
+size_t randomStateSize() {
+  return s_randomCurrent >= 0 ? patternStateSize(s_randomCurrent) : 0;
+}
+
 void randomPattern(CRGB* leds) {
   static unsigned long lastPatternChange = 0;
-  static int currentPatternIndex = -1;
+  int& currentPatternIndex = s_randomCurrent;
   static const char* excludedPatterns[] = {"Draw", "Video", "Type", "Random"};
   static const size_t excludedCount = sizeof(excludedPatterns) / sizeof(excludedPatterns[0]);
   
@@ -582,72 +756,106 @@ void randomPattern(CRGB* leds) {
         }
       }
       
-      // If not excluded, use this pattern
+      // If not excluded, hand over to this pattern
       if (!isExcluded) {
+        if (currentPatternIndex >= 0) {
+          endPattern(currentPatternIndex);
+        }
         currentPatternIndex = newPatternIndex;
+        beginPattern(currentPatternIndex);
         validPattern = true;
       }
     }
   }
   
   // Run the selected pattern
-  if (currentPatternIndex >= 0 && currentPatternIndex < PATTERN_COUNT) {
+  if (currentPatternIndex >= 0 && currentPatternIndex < (int)PATTERN_COUNT) {
     g_patternList[currentPatternIndex].func(leds);
   }
 }
 
+struct Spark {
+    fix16 x;
+    fix16 y;
+    fix8 velX;      // at most 2.2 pixels per frame
+    fix8 velY;
+    uint8_t hue;
+    uint8_t life;
+    bool active;
+};
+
+struct SparklerState {
+    fix16 originX;
+    fix16 originY;
+    uint32_t moveAngle;  // angle in the top 16 bits, fraction below
+    Spark sparks[50];  // Maximum 50 active sparks
+};
+static SparklerState* s_sparkler = nullptr;
+
+void sparklerBegin() {
+    s_sparkler = (SparklerState*)calloc(1, sizeof(SparklerState));
+    if (s_sparkler) {
+        s_sparkler->originX = fix16FromInt(LED_WIDTH / 2);
+        s_sparkler->originY = fix16FromInt(LED_HEIGHT / 2);
+    }
+}
+
+void sparklerEnd() {
+    free(s_sparkler);
+    s_sparkler = nullptr;
+}
+
+size_t sparklerStateSize() {
+    return s_sparkler ? sizeof(SparklerState) : 0;
+}
+
 void sparkler(CRGB* leds) {
-    static float originX = 8.0;
-    static float originY = 8.0;
-    static float moveAngle = 0;
+    setFrameDelay(5);
+    if (!s_sparkler) return;
+    fix16& originX = s_sparkler->originX;
+    fix16& originY = s_sparkler->originY;
+    uint32_t& moveAngle = s_sparkler->moveAngle;
+    Spark* sparks = s_sparkler->sparks;
     
     // Fade existing pixels for trail effect
     fadeToBlackBy(leds, NUM_LEDS, 60);
     
     // Move origin point in a slow circular pattern
-    float moveRadius = 4.0;
-    float targetX = 8 + cos(moveAngle) * moveRadius;
-    float targetY = 8 + sin(moveAngle) * moveRadius;
+    int moveRadius = min(LED_WIDTH, LED_HEIGHT) / 4;
+    uint16_t heading = moveAngle >> 16;
+    fix16 targetX = fix16FromInt(LED_WIDTH / 2) + fix16Cos(heading) * moveRadius;
+    fix16 targetY = fix16FromInt(LED_HEIGHT / 2) + fix16Sin(heading) * moveRadius;
     
-    // Smooth origin movement
-    originX += (targetX - originX) * 0.01;
-    originY += (targetY - originY) * 0.01;
-    moveAngle += 0.005 * (g_Speed / 128.0);
+    // Smooth origin movement, 0.005 radians per frame at normal speed
+    originX = fix16Lerp(originX, targetX, fix16FromFloat(0.01));
+    originY = fix16Lerp(originY, targetY, fix16FromFloat(0.01));
+    moveAngle += (uint32_t)fix16FromFloat(0.005 * 65536 / TWO_PI) * g_Speed / 128;
     
     // Generate new sparks each frame
     uint8_t numNewSparks = random8(3, 8);  // Random number of new sparks per frame
     
-    // Static array to store active sparks
-    static struct {
-        float x;
-        float y;
-        float velX;
-        float velY;
-        uint8_t hue;
-        uint8_t life;
-        bool active;
-    } sparks[50];  // Maximum 50 active sparks
-    
     // Update existing sparks
     for (int i = 0; i < 50; i++) {
         if (sparks[i].active) {
             // Update position based on velocity
-            sparks[i].x += sparks[i].velX;
-            sparks[i].y += sparks[i].velY;
+            sparks[i].x += fix8ToFix16(sparks[i].velX);
+            sparks[i].y += fix8ToFix16(sparks[i].velY);
             
             // Decrease life
             if (sparks[i].life > 0) sparks[i].life--;
             else sparks[i].active = false;
             
             // Check if spark is still in bounds
-            if (sparks[i].x < 0 || sparks[i].x >= 16 || sparks[i].y < 0 || sparks[i].y >= 16) {
+            int16_t sparkX = fix16ToInt(sparks[i].x);
+            int16_t sparkY = fix16ToInt(sparks[i].y);
+            if (sparkX < 0 || sparkX >= LED_WIDTH || sparkY < 0 || sparkY >= LED_HEIGHT) {
                 sparks[i].active = false;
                 continue;
             }
             
             // Draw the spark
-            uint8_t brightness = map(sparks[i].life, 0, 255, 0, 255);
-            leds[XY((uint8_t)sparks[i].x, (uint8_t)sparks[i].y)] += CHSV(sparks[i].hue, 255, brightness);
+            uint8_t brightness = sparks[i].life;
+            leds[XY(sparkX, sparkY)] += CHSV(sparks[i].hue, 255, brightness);
             
             // Add subtle glow to neighbors if spark is bright enough
             if (brightness > 127) {
@@ -655,10 +863,10 @@ void sparkler(CRGB* leds) {
                     for (int8_t dy = -1; dy <= 1; dy++) {
                         if (dx == 0 && dy == 0) continue;
                         
-                        int8_t newX = (uint8_t)sparks[i].x + dx;
-                        int8_t newY = (uint8_t)sparks[i].y + dy;
+                        int16_t newX = sparkX + dx;
+                        int16_t newY = sparkY + dy;
                         
-                        if (newX >= 0 && newX < 16 && newY >= 0 && newY < 16) {
+                        if (newX >= 0 && newX < LED_WIDTH && newY >= 0 && newY < LED_HEIGHT) {
                             leds[XY(newX, newY)] += CHSV(sparks[i].hue, 255, brightness/3);
                         }
                     }
@@ -677,12 +885,12 @@ void sparkler(CRGB* leds) {
                 sparks[j].y = originY;
                 
                 // Random angle and speed
-                float angle = random(256) * (TWO_PI / 256.0);  // Random angle in radians
-                float speed = 0.2 + (random(100) / 50.0);      // Random speed between 0.2 and 2.2
+                uint16_t angle = random(256) << 8;                                     // 256 directions
+                fix16 speed = fix16FromFloat(0.2) + random(100) * (FIX16_ONE / 50);   // 0.2 to 2.2
                 
                 // Calculate velocities
-                sparks[j].velX = cos(angle) * speed;
-                sparks[j].velY = sin(angle) * speed;
+                sparks[j].velX = fix16ToFix8(fix16Mul(fix16Cos(angle), speed));
+                sparks[j].velY = fix16ToFix8(fix16Mul(fix16Sin(angle), speed));
                 
                 // Random color and life
                 sparks[j].hue = random8();
@@ -692,7 +900,4 @@ void sparkler(CRGB* leds) {
             }
         }
     }
-    
-    FastLED.show();
-    nap(5);
 }
\ No newline at end of file
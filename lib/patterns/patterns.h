@@ -3,10 +3,6 @@
 
 #include "config.h"  // Include global configuration first
 
-#ifndef NUM_LEDS
-#define NUM_LEDS 256
-#endif 
-
 #define ARRAY_SIZE(A) (sizeof(A) / sizeof((A)[0]))
 
 #include <led_display.h>
@@ -15,14 +11,31 @@
 // Global brightness variable from main.cpp
 extern int g_Brightness;
 
-// Forward declarations of helper functions
-void nap(int wait);
+// Frame scheduling. Patterns render a single frame per call and must not
+// block; instead they ask for the delay before their next frame. The delay
+// is scaled by g_Speed. If a pattern doesn't ask, the scheduler in main.cpp
+// uses setFrameDelay(1).
+void setFrameDelay(int wait);
+void requestFrame();               // render the next frame right away
+extern uint16_t g_frameDelay;      // period requested for the next frame (ms)
+extern uint32_t g_frameDeltaMs;    // time since the previous frame (ms)
+extern volatile bool g_frameRequested;
+extern TaskHandle_t g_renderTask;  // woken early by requestFrame()
 
 // 1) Define a struct to hold pattern info (name + function pointer).
+//    func renders one frame each time the scheduler ticks (g_frameDeltaMs
+//    is the time since the previous tick). The lifecycle hooks are optional
+//    and may be left out of the initializer:
+//      begin     - pattern is switched in; allocate and reset its state
+//      end       - pattern is switched out; release its state
+//      stateSize - bytes of working state currently held by the pattern
 struct Pattern {
     const char* name;
     void (*func)(CRGB* leds);
     const char* icon;  // UTF-8 emoji or character icon
+    void (*begin)();
+    void (*end)();
+    size_t (*stateSize)();
 };
 
 // 2) Declare an array of Pattern objects
@@ -31,4 +44,22 @@ extern Pattern g_patternList[];
 // 3) Declare a variable that represents the number of patterns
 extern const size_t PATTERN_COUNT;
 
+// Lifecycle helpers, safe to call for patterns without hooks
+void beginPattern(size_t index);
+void endPattern(size_t index);
+size_t patternStateSize(size_t index);
+
+// Game of Life (the "Game of Life" pattern). Edges wrap around, so the
+// board is a torus, unless built with -D LIFE_WRAP=0, in which case cells
+// beyond the edges are dead.
+#ifndef LIFE_WRAP
+#define LIFE_WRAP 1
+#endif
+
+// One generation of a width x height board from `board` into `next`.
+// Boards are bit-packed, one bit per cell: each row is (width + 31) / 32
+// words, with bit x % 32 of word x / 32 holding column x and the bits past
+// the last column clear. Returns the new population.
+uint16_t lifeStep(const uint32_t* board, uint32_t* next, uint16_t width, uint16_t height);
+
 #endif // PATTERNS_H
\ No newline at end of file
@@ -1,10 +1,14 @@
 #include "snake.h"
 #include <led_display.h>
 #include <FastLED.h>
+#include <commands.h>
+#include <webassets.h>
 
 // Game constants
-#define GRID_SIZE 16
-#define MAX_SNAKE_LENGTH 256 // Maximum possible length (16x16 grid)
+// The playing field is the whole display
+#define GRID_WIDTH  LED_WIDTH
+#define GRID_HEIGHT LED_HEIGHT
+#define MAX_SNAKE_LENGTH LED_MAX_LEDS // Maximum possible length (every cell)
 #define INITIAL_SNAKE_LENGTH 3
 #define GAME_SPEED 150      // Movement speed in milliseconds (constant)
 
@@ -16,8 +20,8 @@ enum GameState {
 };
 
 // Game variables
-static int snakeX[MAX_SNAKE_LENGTH];
-static int snakeY[MAX_SNAKE_LENGTH];
+static int16_t snakeX[MAX_SNAKE_LENGTH];
+static int16_t snakeY[MAX_SNAKE_LENGTH];
 static int snakeLength;
 static Direction direction;
 static Direction nextDirection; // For handling quick direction changes
@@ -35,9 +39,6 @@ static unsigned long gameOverTime; // Time when game ended for auto-restart
 // AI mode flag
 static bool aiMode = false;
 
-// Global flag for game initialization state
-static bool g_snakeInitialized = false;
-
 // Place food at a random position not occupied by the snake
 void placeFood() {
   bool validPosition;
@@ -45,8 +46,8 @@ void placeFood() {
   // Keep trying until we find a valid position
   do {
     validPosition = true;
-    foodX = random(GRID_SIZE);
-    foodY = random(GRID_SIZE);
+    foodX = random(GRID_WIDTH);
+    foodY = random(GRID_HEIGHT);
     
     // Check if food spawned on snake
     for (int i = 0; i < snakeLength; i++) {
@@ -62,8 +63,8 @@ void placeFood() {
 void initSnakeGame() {
   // Initialize snake in the middle of the grid
   snakeLength = INITIAL_SNAKE_LENGTH;
-  int middleX = GRID_SIZE / 2;
-  int middleY = GRID_SIZE / 2;
+  int middleX = GRID_WIDTH / 2;
+  int middleY = GRID_HEIGHT / 2;
   
   for (int i = 0; i < snakeLength; i++) {
     snakeX[i] = middleX - i;
@@ -111,9 +112,9 @@ Direction getAIMove() {
   
   // Check which directions are safe (no wall or self collision)
   bool canMoveUp = (headY > 0);
-  bool canMoveDown = (headY < GRID_SIZE - 1);
+  bool canMoveDown = (headY < GRID_HEIGHT - 1);
   bool canMoveLeft = (headX > 0);
-  bool canMoveRight = (headX < GRID_SIZE - 1);
+  bool canMoveRight = (headX < GRID_WIDTH - 1);
   
   // Check for self collisions
   for (int i = 0; i < snakeLength; i++) {
@@ -155,7 +156,6 @@ void updateSnakeGame() {
   if (gameState == GAME_OVER) {
     // If in AI mode and game over, auto-restart after 5 seconds
     if (aiMode && (millis() - gameOverTime >= 5000)) {
-      g_snakeInitialized = false;
       initSnakeGame();
       return;
     }
@@ -202,8 +202,8 @@ void updateSnakeGame() {
                   snakeX[0], snakeY[0], newHeadX, newHeadY, (int)direction);
     
     // Check for wall collision
-    if (newHeadX < 0 || newHeadX >= GRID_SIZE ||
-        newHeadY < 0 || newHeadY >= GRID_SIZE) {
+    if (newHeadX < 0 || newHeadX >= GRID_WIDTH ||
+        newHeadY < 0 || newHeadY >= GRID_HEIGHT) {
       Serial.println("Game over: Wall collision!");
       gameState = GAME_OVER;
       gameOverTime = millis(); // Record when game ended
@@ -245,8 +245,8 @@ void updateSnakeGame() {
       // Now it's safe to increase the length
       snakeLength++;
       
-      if (snakeLength >= MAX_SNAKE_LENGTH) {
-        // Snake reached maximum size - you win!
+      if (snakeLength >= NUM_LEDS) {
+        // Snake fills the display - you win!
         Serial.println("You win! Maximum snake length reached.");
         gameState = GAME_OVER;
         return;
@@ -274,15 +274,15 @@ void renderSnakeGame(CRGB* leds) {
   
   // Draw the snake body
   for (int i = 1; i < snakeLength; i++) {
-    if (snakeX[i] >= 0 && snakeX[i] < GRID_SIZE && 
-        snakeY[i] >= 0 && snakeY[i] < GRID_SIZE) {
+    if (snakeX[i] >= 0 && snakeX[i] < GRID_WIDTH && 
+        snakeY[i] >= 0 && snakeY[i] < GRID_HEIGHT) {
       leds[XY(snakeX[i], snakeY[i])] = snakeColor;
     }
   }
   
   // Draw the snake head - always last to ensure it's visible
-  if (snakeX[0] >= 0 && snakeX[0] < GRID_SIZE && 
-      snakeY[0] >= 0 && snakeY[0] < GRID_SIZE) {
+  if (snakeX[0] >= 0 && snakeX[0] < GRID_WIDTH && 
+      snakeY[0] >= 0 && snakeY[0] < GRID_HEIGHT) {
     // Make head brighter than body
     CRGB brightHead = headColor;
     brightHead.maximizeBrightness();
@@ -303,17 +303,60 @@ void renderSnakeGame(CRGB* leds) {
   }
 }
 
+// Handle a direction command from /snakeControl (applied by the render task)
+void snakeApplyDirection(const char* dir) {
+  // If game is in WAITING state, automatically start it on first direction command
+  if (gameState == WAITING) {
+    gameState = PLAYING;
+    Serial.println("Game state changed to PLAYING via direction command");
+  }
+  
+  if (strcmp(dir, "up") == 0) {
+    setDirection(UP);
+    Serial.println("Direction set to UP");
+  } else if (strcmp(dir, "down") == 0) {
+    setDirection(DOWN);
+    Serial.println("Direction set to DOWN");
+  } else if (strcmp(dir, "left") == 0) {
+    setDirection(LEFT);
+    Serial.println("Direction set to LEFT");
+  } else if (strcmp(dir, "right") == 0) {
+    setDirection(RIGHT);
+    Serial.println("Direction set to RIGHT");
+  }
+}
+
+// Handle a game action from /snakeControl (applied by the render task)
+void snakeApplyAction(const char* action) {
+  if (strcmp(action, "start") == 0) {
+    // Always allow starting the game
+    gameState = PLAYING;
+    Serial.println("Game state changed to PLAYING via start action");
+  } else if (strcmp(action, "restart") == 0) {
+    initSnakeGame();
+    Serial.println("Game restarted");
+  } else if (strcmp(action, "aiOn") == 0) {
+    // Enable AI mode
+    aiMode = true;
+    Serial.println("AI mode enabled");
+  } else if (strcmp(action, "aiOff") == 0) {
+    // Disable AI mode
+    aiMode = false;
+    Serial.println("AI mode disabled");
+  }
+}
+
+// Start a fresh game every time the pattern is switched in
+void snakeBegin() {
+  initSnakeGame();
+  Serial.println("Snake game started.");
+}
+
 // Main pattern function that will be called from patterns.cpp
 void snake(CRGB* leds) {
   // Initialize game if needed
   static unsigned long lastDebugTime = 0;
   
-  if (!g_snakeInitialized) {
-    initSnakeGame();
-    g_snakeInitialized = true;
-    Serial.println("Snake game started.");
-  }
-  
   // Debug: Print game state every 5 seconds
   unsigned long currentTime = millis();
   if (currentTime - lastDebugTime > 5000) {
@@ -340,312 +383,24 @@ void toggleAIModeSnake() {
 // Web server setup function
 void setupSnakePattern(AsyncWebServer* server) {
   // Serve the snake game control page
-  server->on("/snake", HTTP_GET, [](AsyncWebServerRequest *request) {
-    String html = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-    <title>PixelBoard Snake Game</title>
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <link rel="stylesheet" href="/style.css">
-</head>
-<body>
-    <div class="header">
-        <div class="header-left">
-            <h1>PixelBoard Snake</h1>
-            <div class="score">Score: <span id="scoreValue">0</span></div>
-            <div class="status" id="gameStatus">Press Start to Play</div>
-        </div>
-        <div class="header-right">
-            <button class="d-btn" id="btnStart">Start Game</button>
-            <button class="d-btn" id="btnRestart">Restart</button>
-            <button class="d-btn" id="btnAI">Enable AI</button>
-        </div>
-    </div>
-    
-    <div class="preview-container">
-        <div class="preview-grid" id="previewGrid"></div>
-    </div>
-    
-    <div class="controls">
-        <div class="d-pad">
-            <button class="d-btn up" id="btnUp"><span class="key-icon">&uarr;</span></button>
-            <button class="d-btn left" id="btnLeft"><span class="key-icon">&larr;</span></button>
-            <div class="center"></div>
-            <button class="d-btn right" id="btnRight"><span class="key-icon">&rarr;</span></button>
-            <button class="d-btn down" id="btnDown"><span class="key-icon">&darr;</span></button>
-        </div>
-    </div>
-
-    <div style="text-align: center; margin: 5px; font-size: 0.8rem; color: #aaa;">
-        Keyboard: Use arrow keys to control
-    </div>
-    
-    <script>
-        let previewUpdateInterval;
-        let gameState = 'waiting';
-        let aiMode = false;
-        
-        // Create preview grid
-        function createPreviewGrid() {
-            const grid = document.getElementById('previewGrid');
-            for (let i = 0; i < 256; i++) {
-                const pixel = document.createElement('div');
-                pixel.className = 'preview-pixel';
-                pixel.id = 'pixel-' + i;
-                grid.appendChild(pixel);
-            }
-        }
-        
-        // Update the preview grid
-        function updatePreview() {
-            fetch('/pixelStatus')
-                .then(response => response.arrayBuffer())
-                .then(buffer => {
-                    const pixels = new Uint8Array(buffer);
-                    for (let i = 0; i < 256; i++) {
-                        const baseIndex = i * 3;
-                        const r = pixels[baseIndex];
-                        const g = pixels[baseIndex + 1];
-                        const b = pixels[baseIndex + 2];
-                        
-                        const pixelElement = document.getElementById('pixel-' + i);
-                        if (pixelElement) {
-                            pixelElement.style.backgroundColor = `rgb(${r},${g},${b})`;
-                        }
-                    }
-                })
-                .catch(error => console.error('Error updating preview:', error));
-                
-            // Update game state
-            fetchGameState();
-        }
-        
-        // Fetch game state from server
-        function fetchGameState() {
-            fetch('/snakeState')
-                .then(response => response.json())
-                .then(data => {
-                    // Update game state
-                    gameState = data.state;
-                    
-                    // Update score
-                    document.getElementById('scoreValue').textContent = data.score;
-                    
-                    // Update game status text
-                    const statusElement = document.getElementById('gameStatus');
-                    switch (data.state) {
-                        case 'waiting':
-                            statusElement.textContent = 'Press Start to Play';
-                            break;
-                        case 'playing':
-                            statusElement.textContent = 'Game In Progress';
-                            break;
-                        case 'gameover':
-                            statusElement.textContent = 'Game Over! Press Restart';
-                            break;
-                    }
-                    
-                    // Update AI mode if it changed
-                    if (aiMode !== data.aiMode) {
-                        aiMode = data.aiMode;
-                        updateAIButton();
-                    }
-                })
-                .catch(error => console.error('Error fetching game state:', error));
-        }
-        
-        // Send direction immediately without tracking current direction
-        function sendDirection(direction) {
-            fetch(`/snakeControl?dir=${direction}`)
-                .then(response => response.text())
-                .catch(error => console.error('Error sending direction:', error));
-        }
-        
-        function startGame() {
-            fetch('/snakeControl?action=start')
-                .then(response => response.text())
-                .then(() => {
-                    gameState = 'playing';
-                    document.getElementById('gameStatus').textContent = 'Game In Progress';
-                })
-                .catch(error => console.error('Error starting game:', error));
-        }
-        
-        function restartGame() {
-            fetch('/snakeControl?action=restart')
-                .then(response => response.text())
-                .then(() => {
-                    gameState = 'playing';
-                    document.getElementById('gameStatus').textContent = 'Game In Progress';
-                    document.getElementById('scoreValue').textContent = '0';
-                })
-                .catch(error => console.error('Error restarting game:', error));
-        }
-        
-        // Toggle AI mode
-        function toggleAIMode() {
-            aiMode = !aiMode;
-            updateAIButton();
-            
-            fetch(`/snakeControl?action=${aiMode ? 'aiOn' : 'aiOff'}`)
-                .then(response => response.text())
-                .catch(error => console.error('Error toggling AI mode:', error));
-        }
-        
-        // Update AI button appearance
-        function updateAIButton() {
-            const aiButton = document.getElementById('btnAI');
-            if (aiMode) {
-                aiButton.textContent = 'Disable AI';
-                aiButton.classList.add('active');
-                // When AI mode is enabled, disable manual controls except AI and Restart buttons
-                document.querySelectorAll('.d-btn:not(#btnAI):not(#btnRestart)').forEach(btn => {
-                    btn.disabled = true;
-                    btn.style.opacity = 0.5;
-                });
-            } else {
-                aiButton.textContent = 'Enable AI';
-                aiButton.classList.remove('active');
-                // Re-enable manual controls
-                document.querySelectorAll('.d-btn').forEach(btn => {
-                    btn.disabled = false;
-                    btn.style.opacity = 1;
-                });
-            }
-        }
-        
-        // Add event listeners
-        document.getElementById('btnUp').addEventListener('click', () => {
-            if (!aiMode && gameState === 'playing') {
-                sendDirection('up');
-            } else if (gameState === 'waiting') {
-                startGame();
-                sendDirection('up');
-            }
-        });
-        
-        document.getElementById('btnDown').addEventListener('click', () => {
-            if (!aiMode && gameState === 'playing') {
-                sendDirection('down');
-            } else if (gameState === 'waiting') {
-                startGame();
-                sendDirection('down');
-            }
-        });
-        
-        document.getElementById('btnLeft').addEventListener('click', () => {
-            if (!aiMode && gameState === 'playing') {
-                sendDirection('left');
-            } else if (gameState === 'waiting') {
-                startGame();
-                sendDirection('left');
-            }
-        });
-        
-        document.getElementById('btnRight').addEventListener('click', () => {
-            if (!aiMode && gameState === 'playing') {
-                sendDirection('right');
-            } else if (gameState === 'waiting') {
-                startGame();
-                sendDirection('right');
-            }
-        });
-        
-        document.getElementById('btnStart').addEventListener('click', startGame);
-        document.getElementById('btnRestart').addEventListener('click', restartGame);
-        document.getElementById('btnAI').addEventListener('click', toggleAIMode);
-        
-        // Add keyboard controls
-        document.addEventListener('keydown', function(e) {
-            if (!aiMode && (gameState === 'playing' || gameState === 'waiting')) {
-                switch(e.key) {
-                    case 'ArrowUp':
-                        if (gameState === 'waiting') startGame();
-                        sendDirection('up');
-                        break;
-                    case 'ArrowDown':
-                        if (gameState === 'waiting') startGame();
-                        sendDirection('down');
-                        break;
-                    case 'ArrowLeft':
-                        if (gameState === 'waiting') startGame();
-                        sendDirection('left');
-                        break;
-                    case 'ArrowRight':
-                        if (gameState === 'waiting') startGame();
-                        sendDirection('right');
-                        break;
-                }
-            }
-        });
-        
-        // Initialize with faster preview updates
-        document.addEventListener('DOMContentLoaded', function() {
-            createPreviewGrid();
-            updatePreview();
-            previewUpdateInterval = setInterval(updatePreview, 50);
-        });
-    </script>
-</body>
-</html>
-)rawliteral";
-    request->send(200, "text/html", html);
-  });
+  webServeAsset(server, "/snake", WEB_SNAKE_HTML);
   
   // API endpoint to control the snake
   server->on("/snakeControl", HTTP_GET, [](AsyncWebServerRequest *request) {
-    // Handle direction commands
+    // Game state belongs to the render task, so queue the input for it
+    bool queued = true;
     if (request->hasParam("dir")) {
-      String dir = request->getParam("dir")->value();
-      
-      // If game is in WAITING state, automatically start it on first direction command
-      if (gameState == WAITING) {
-        gameState = PLAYING;
-        Serial.println("Game state changed to PLAYING via direction command");
-      }
-      
-      if (dir == "up") {
-        setDirection(UP);
-        Serial.println("Direction set to UP");
-      } else if (dir == "down") {
-        setDirection(DOWN);
-        Serial.println("Direction set to DOWN");
-      } else if (dir == "left") {
-        setDirection(LEFT);
-        Serial.println("Direction set to LEFT");
-      } else if (dir == "right") {
-        setDirection(RIGHT);
-        Serial.println("Direction set to RIGHT");
-      }
+      queued &= commandPost(CMD_SNAKE_DIRECTION, 0, request->getParam("dir")->value().c_str());
     }
-    
-    // Handle game actions
     if (request->hasParam("action")) {
-      String action = request->getParam("action")->value();
-      
-      if (action == "start") {
-        // Always allow starting the game
-        gameState = PLAYING;
-        Serial.println("Game state changed to PLAYING via start action");
-      } else if (action == "restart") {
-        // Reset the initialized flag to force reinitialization
-        g_snakeInitialized = false;
-        
-        initSnakeGame();
-        Serial.println("Game restarted");
-      } else if (action == "aiOn") {
-        // Enable AI mode
-        aiMode = true;
-        Serial.println("AI mode enabled");
-      } else if (action == "aiOff") {
-        // Disable AI mode
-        aiMode = false;
-        Serial.println("AI mode disabled");
-      }
+      queued &= commandPost(CMD_SNAKE_ACTION, 0, request->getParam("action")->value().c_str());
     }
     
-    request->send(200, "text/plain", "OK");
+    if (queued) {
+      request->send(200, "text/plain", "OK");
+    } else {
+      request->send(503, "text/plain", "Busy");
+    }
   });
   
   // API endpoint to get game state
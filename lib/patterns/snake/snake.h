@@ -23,6 +23,9 @@ void toggleAIModeSnake();
 
 // Function declarations for the snake pattern
 void snake(CRGB* leds);
+void snakeBegin();
+void snakeApplyDirection(const char* dir);
+void snakeApplyAction(const char* action);
 void setupSnakePattern(AsyncWebServer* server);
 
 #endif // SNAKE_H 
\ No newline at end of file
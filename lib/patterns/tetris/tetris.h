@@ -43,6 +43,8 @@ void spawnTetromino();
 
 // Main pattern function
 void tetris(CRGB* leds);
+void tetrisBegin();
+void tetrisApplyAction(const char* action);
 void setupTetrisPattern(AsyncWebServer* server);
 
 #endif // TETRIS_H 
\ No newline at end of file
@@ -0,0 +1,342 @@
+#include "tetris_ai.h"
+
+// Tetromino definitions (4x4 grids)
+const uint8_t TETROMINOS[TETRIS_PIECES][4][4] = {
+    // I-piece
+    {
+        {0,0,0,0},
+        {1,1,1,1},
+        {0,0,0,0},
+        {0,0,0,0}
+    },
+    // O-piece
+    {
+        {0,1,1,0},
+        {0,1,1,0},
+        {0,0,0,0},
+        {0,0,0,0}
+    },
+    // T-piece
+    {
+        {0,1,0,0},
+        {1,1,1,0},
+        {0,0,0,0},
+        {0,0,0,0}
+    },
+    // S-piece
+    {
+        {0,1,1,0},
+        {1,1,0,0},
+        {0,0,0,0},
+        {0,0,0,0}
+    },
+    // Z-piece
+    {
+        {1,1,0,0},
+        {0,1,1,0},
+        {0,0,0,0},
+        {0,0,0,0}
+    },
+    // J-piece
+    {
+        {1,0,0,0},
+        {1,1,1,0},
+        {0,0,0,0},
+        {0,0,0,0}
+    },
+    // L-piece
+    {
+        {0,0,1,0},
+        {1,1,1,0},
+        {0,0,0,0},
+        {0,0,0,0}
+    }
+};
+
+// Found with the simulator's tuning harness (program --tetris 100
+// --max-pieces 1000 --tune 300); see the ReadMe
+const TetrisWeights TETRIS_DEFAULT_WEIGHTS = {
+    76,   // lines
+    59,   // holes
+    10,   // bumpiness
+    53,   // aggregateHeight
+    4,    // maxHeight
+    5     // wells
+};
+
+// Every rotation of every piece as row masks, built on first use. Turning
+// the 4x4 grid moves the cells around inside it just like the game's
+// rotateTetromino() does, so x and y mean the same thing in both.
+struct PieceShape {
+    uint8_t rows[4];   // bit c: cell in grid column c
+    int8_t minCol, maxCol, minRow, maxRow;
+    uint8_t id;        // same id, same cells: rotations that look alike
+};
+static PieceShape s_shapes[TETRIS_PIECES][4];
+
+static bool buildShapes() {
+    for (uint8_t type = 0; type < TETRIS_PIECES; type++) {
+        uint8_t grid[4][4];
+        memcpy(grid, TETROMINOS[type], sizeof(grid));
+
+        for (uint8_t rot = 0; rot < 4; rot++) {
+            PieceShape& s = s_shapes[type][rot];
+            s.minCol = s.minRow = 4;
+            s.maxCol = s.maxRow = -1;
+            for (int8_t y = 0; y < 4; y++) {
+                s.rows[y] = 0;
+                for (int8_t x = 0; x < 4; x++) {
+                    if (!grid[y][x]) continue;
+                    s.rows[y] |= 1 << x;
+                    s.minCol = min(s.minCol, x);
+                    s.maxCol = max(s.maxCol, x);
+                    s.minRow = min(s.minRow, y);
+                    s.maxRow = max(s.maxRow, y);
+                }
+            }
+
+            // Compare with the earlier rotations, moved to the same corner
+            s.id = rot;
+            for (uint8_t other = 0; other < rot && s.id == rot; other++) {
+                const PieceShape& o = s_shapes[type][other];
+                bool same = true;
+                for (int8_t y = 0; y < 4 && same; y++) {
+                    int8_t sy = s.minRow + y, oy = o.minRow + y;
+                    uint8_t a = sy < 4 ? s.rows[sy] >> s.minCol : 0;
+                    uint8_t b = oy < 4 ? o.rows[oy] >> o.minCol : 0;
+                    same = a == b;
+                }
+                if (same) s.id = o.id;
+            }
+
+            // Rotate 90 degrees clockwise for the next one
+            uint8_t turned[4][4];
+            for (int y = 0; y < 4; y++) {
+                for (int x = 0; x < 4; x++) {
+                    turned[x][3 - y] = grid[y][x];
+                }
+            }
+            memcpy(grid, turned, sizeof(grid));
+        }
+    }
+    return true;
+}
+
+// Builds the table on the first call; a function static, so this is safe
+// when the simulator's tuning harness plays games on several threads
+static inline void ensureShapes() {
+    static const bool built = buildShapes();
+    (void)built;
+}
+
+static inline const PieceShape& shapeOf(const TetrisPiece& piece) {
+    ensureShapes();
+    return s_shapes[piece.type][piece.rotation];
+}
+
+// Row mask of grid row `r` with the grid's left edge at column x; the
+// caller has checked the piece is inside the board
+static inline uint16_t rowMask(const PieceShape& s, uint8_t r, int8_t x) {
+    return x >= 0 ? (uint16_t)s.rows[r] << x : s.rows[r] >> -x;
+}
+
+static bool collides(const TetrisBoard& board, const PieceShape& s, int8_t x, int8_t y) {
+    if (x + s.minCol < 0 || x + s.maxCol >= TETRIS_COLS ||
+        y + s.minRow < 0 || y + s.maxRow >= TETRIS_ROWS) {
+        return true;
+    }
+    for (int8_t r = s.minRow; r <= s.maxRow; r++) {
+        if (board.rows[y + r] & rowMask(s, r, x)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool tetrisCollides(const TetrisBoard& board, const TetrisPiece& piece) {
+    return collides(board, shapeOf(piece), piece.x, piece.y);
+}
+
+bool tetrisRotate(const TetrisBoard& board, TetrisPiece& piece) {
+    TetrisPiece turned = piece;
+    turned.rotation = (piece.rotation + 1) % 4;
+    if (tetrisCollides(board, turned)) {
+        return false;
+    }
+    piece = turned;
+    return true;
+}
+
+uint8_t tetrisLock(TetrisBoard& board, const TetrisPiece& piece) {
+    const PieceShape& s = shapeOf(piece);
+    for (int8_t r = s.minRow; r <= s.maxRow; r++) {
+        board.rows[piece.y + r] |= rowMask(s, r, piece.x);
+    }
+
+    // Drop the full rows, moving the rest down
+    uint8_t lines = 0;
+    int8_t to = TETRIS_ROWS - 1;
+    for (int8_t from = TETRIS_ROWS - 1; from >= 0; from--) {
+        if (board.rows[from] == TETRIS_FULL_ROW) {
+            lines++;
+        } else {
+            board.rows[to--] = board.rows[from];
+        }
+    }
+    while (to >= 0) {
+        board.rows[to--] = 0;
+    }
+    return lines;
+}
+
+TetrisPiece tetrisSpawn(uint8_t type) {
+    return TetrisPiece{type, 0, TETRIS_SPAWN_X, 0};
+}
+
+TetrisDirection tetrisAIStep(const TetrisPlan& plan, const TetrisPiece& piece) {
+    if (piece.rotation != plan.rotation) return T_ROTATE;
+    if (piece.x < plan.targetX) return T_RIGHT;
+    if (piece.x > plan.targetX) return T_LEFT;
+    return T_DOWN;
+}
+
+bool tetrisAIAdvance(const TetrisBoard& board, const TetrisPlan& plan, TetrisPiece& piece) {
+    TetrisDirection move = tetrisAIStep(plan, piece);
+    if (move == T_ROTATE) {
+        tetrisRotate(board, piece);
+    } else if (move != T_DOWN) {
+        int8_t dx = move == T_RIGHT ? 1 : -1;
+        piece.x += dx;
+        if (tetrisCollides(board, piece)) piece.x -= dx;
+    }
+    piece.y++;
+    if (tetrisCollides(board, piece)) {
+        piece.y--;
+        return false;
+    }
+    return true;
+}
+
+// Play `plan` out and leave `piece` where it locks
+static void playPlan(const TetrisBoard& board, TetrisPiece& piece, const TetrisPlan& plan) {
+    while (tetrisAIStep(plan, piece) != T_DOWN) {
+        if (!tetrisAIAdvance(board, plan, piece)) return;
+    }
+    // Lined up; the rest is a straight drop
+    const PieceShape& s = shapeOf(piece);
+    while (!collides(board, s, piece.x, piece.y + 1)) {
+        piece.y++;
+    }
+}
+
+// A plan and where the piece locks when it's played
+struct Placement {
+    TetrisPlan plan;
+    TetrisPiece end;
+};
+
+// Placements of `piece` on `board`: each rotation and target column played
+// out, duplicates (same cells, reached another way) dropped
+static uint8_t enumeratePlacements(const TetrisBoard& board, const TetrisPiece& piece,
+                                   Placement* out) {
+    uint8_t count = 0;
+    uint32_t seen[TETRIS_MAX_PLACEMENTS];
+    for (uint8_t turns = 0; turns < 4; turns++) {
+        TetrisPlan plan = {};
+        plan.rotation = (piece.rotation + turns) % 4;
+        const PieceShape& s = s_shapes[piece.type][plan.rotation];
+        for (int8_t x = -s.minCol; x + s.maxCol < TETRIS_COLS; x++) {
+            plan.targetX = x;
+            TetrisPiece end = piece;
+            playPlan(board, end, plan);
+            plan.landingY = end.y;
+
+            // Where the cells ended up, whatever the rotation index
+            const PieceShape& e = s_shapes[end.type][end.rotation];
+            uint32_t key = (uint32_t)e.id << 16 | (uint8_t)(end.x + e.minCol) << 8 | (uint8_t)(end.y + e.minRow);
+            bool duplicate = false;
+            for (uint8_t i = 0; i < count && !duplicate; i++) {
+                duplicate = seen[i] == key;
+            }
+            if (!duplicate && count < TETRIS_MAX_PLACEMENTS) {
+                seen[count] = key;
+                out[count++] = Placement{plan, end};
+            }
+        }
+    }
+    return count;
+}
+
+// Score a board after its lines have cleared. Holes and column heights
+// come from one pass down the rows: `covered` has a bit for every column
+// that has had a block above.
+static int32_t evaluate(const TetrisBoard& board, uint8_t lines, const TetrisWeights& w) {
+    uint8_t heights[TETRIS_COLS] = {0};
+    uint16_t covered = 0;
+    int32_t holes = 0;
+    for (uint8_t y = 0; y < TETRIS_ROWS; y++) {
+        uint16_t row = board.rows[y];
+        for (uint16_t top = row & ~covered; top; top &= top - 1) {
+            heights[__builtin_ctz(top)] = TETRIS_ROWS - y;
+        }
+        covered |= row;
+        holes += __builtin_popcount(covered & ~row);
+    }
+
+    int32_t aggregate = 0, maxHeight = 0, bumpiness = 0, wells = 0;
+    for (uint8_t x = 0; x < TETRIS_COLS; x++) {
+        aggregate += heights[x];
+        maxHeight = max<int32_t>(maxHeight, heights[x]);
+        if (x > 0) bumpiness += abs(heights[x] - heights[x - 1]);
+
+        // The walls count as full columns
+        int32_t left = x > 0 ? heights[x - 1] : TETRIS_ROWS;
+        int32_t right = x + 1 < TETRIS_COLS ? heights[x + 1] : TETRIS_ROWS;
+        int32_t depth = min(left, right) - heights[x];
+        if (depth > 0) wells += depth * (depth + 1) / 2;
+    }
+
+    return lines * w.lines - holes * w.holes - bumpiness * w.bumpiness -
+           aggregate * w.aggregateHeight - maxHeight * w.maxHeight - wells * w.wells;
+}
+
+bool tetrisAIPlan(const TetrisBoard& board, const TetrisPiece& piece, int8_t nextType,
+                  const TetrisWeights& weights, TetrisPlan* plan, TetrisAIStats* stats) {
+    ensureShapes();
+    Placement placements[TETRIS_MAX_PLACEMENTS], nextPlacements[TETRIS_MAX_PLACEMENTS];
+    uint8_t count = enumeratePlacements(board, piece, placements);
+    stats->placements = count;
+
+    bool found = false;
+    for (uint8_t i = 0; i < count; i++) {
+        TetrisBoard after = board;
+        uint8_t lines = tetrisLock(after, placements[i].end);
+
+        int32_t score;
+        if (nextType < 0) {
+            score = evaluate(after, lines, weights);
+            stats->evaluations++;
+        } else {
+            // Score it by the best the next piece can do afterwards; a
+            // placement that leaves no room for it ends the game
+            TetrisPiece next = tetrisSpawn(nextType);
+            score = INT32_MIN;
+            if (!tetrisCollides(after, next)) {
+                uint8_t nextCount = enumeratePlacements(after, next, nextPlacements);
+                for (uint8_t j = 0; j < nextCount; j++) {
+                    TetrisBoard last = after;
+                    uint8_t nextLines = tetrisLock(last, nextPlacements[j].end);
+                    score = max(score, evaluate(last, lines + nextLines, weights));
+                    stats->evaluations++;
+                }
+            }
+        }
+
+        if (!found || score > plan->score) {
+            *plan = placements[i].plan;
+            plan->score = score;
+            found = true;
+        }
+    }
+    return found;
+}
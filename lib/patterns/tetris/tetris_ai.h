@@ -0,0 +1,82 @@
+#ifndef TETRIS_AI_H
+#define TETRIS_AI_H
+
+#include <Arduino.h>
+#include "tetris.h"
+
+// Tetris rules on bitboards, and the AI that plays them. The board is one
+// uint16_t per row, bit x for column x and row 0 at the top, so collision
+// tests, line checks and board features are a few word operations per
+// row. tetris.cpp keeps its own colored board for display and hands the
+// AI a bitboard copy once per piece.
+
+#define TETRIS_COLS      16
+#define TETRIS_ROWS      16
+#define TETRIS_PIECES    7
+#define TETRIS_SPAWN_X   ((TETRIS_COLS - 4) / 2)
+#define TETRIS_FULL_ROW  ((uint16_t)((1u << TETRIS_COLS) - 1))
+#define TETRIS_MAX_PLACEMENTS 64   // 4 rotations x every column
+
+// The seven tetrominoes in their spawn orientation, as 4x4 grids
+extern const uint8_t TETROMINOS[TETRIS_PIECES][4][4];
+
+struct TetrisBoard {
+    uint16_t rows[TETRIS_ROWS];
+};
+
+// A piece in play: `rotation` quarter turns clockwise from the spawn
+// shape, its 4x4 grid's top left corner at (x, y)
+struct TetrisPiece {
+    uint8_t type;
+    uint8_t rotation;
+    int8_t x;
+    int8_t y;
+};
+
+// Evaluation weights; a placement scores lines * lines minus the other
+// features times theirs, all measured on the board after lines clear
+struct TetrisWeights {
+    int16_t lines;            // per line cleared
+    int16_t holes;            // per empty cell with a block somewhere above
+    int16_t bumpiness;        // per step in height between neighboring columns
+    int16_t aggregateHeight;  // per cell of column height, summed
+    int16_t maxHeight;        // per cell of the tallest column
+    int16_t wells;            // per cell of well depth, 1 + 2 + .. for deep wells
+};
+extern const TetrisWeights TETRIS_DEFAULT_WEIGHTS;
+
+// Where the AI wants the current piece to end up. The game gets there one
+// step per tick via tetrisAIStep(); planning has already played those
+// steps, gravity included, so every plan is reachable.
+struct TetrisPlan {
+    uint8_t rotation;   // absolute rotation to turn to
+    int8_t targetX;
+    int8_t landingY;
+    int32_t score;
+};
+
+struct TetrisAIStats {
+    uint32_t evaluations;  // boards scored
+    uint16_t placements;   // distinct placements of the current piece
+};
+
+// Rules
+bool tetrisCollides(const TetrisBoard& board, const TetrisPiece& piece);
+bool tetrisRotate(const TetrisBoard& board, TetrisPiece& piece);    // false if blocked
+uint8_t tetrisLock(TetrisBoard& board, const TetrisPiece& piece);   // returns lines cleared
+TetrisPiece tetrisSpawn(uint8_t type);
+
+// Pick a placement for `piece`. With `nextType` >= 0 every placement is
+// scored by the best placement of the next piece after it (one-piece
+// lookahead). Returns false if the piece has nowhere to go.
+bool tetrisAIPlan(const TetrisBoard& board, const TetrisPiece& piece, int8_t nextType,
+                  const TetrisWeights& weights, TetrisPlan* plan, TetrisAIStats* stats);
+
+// The move that takes `piece` one step along `plan`; T_DOWN once it's there
+TetrisDirection tetrisAIStep(const TetrisPlan& plan, const TetrisPiece& piece);
+
+// One AI tick: make that move, then let the piece fall a row. Returns
+// false, with `piece` where it stopped, if the fall made it lock.
+bool tetrisAIAdvance(const TetrisBoard& board, const TetrisPlan& plan, TetrisPiece& piece);
+
+#endif // TETRIS_AI_H
@@ -1,5 +1,7 @@
 #include "type.h"
 #include <led_display.h>
+#include <commands.h>
+#include <webassets.h>
 #include "freemono.h" // Include the FreeMono font
 #include "font_test.h" // Include the test font
 
@@ -235,11 +237,11 @@ void drawChar(CRGB* leds, char c, int xOffset, int yOffset) {
     int charIndex = getCharIndex(c);
     
     for (int x = 0; x < 5; x++) {
-        if (xOffset + x < 0 || xOffset + x >= 16) continue;
+        if (xOffset + x < 0 || xOffset + x >= LED_WIDTH) continue;
         
         uint8_t column = pgm_read_byte(&font5x7[charIndex * 5 + x]);
         for (int y = 0; y < 7; y++) {
-            if (yOffset + y < 0 || yOffset + y >= 16) continue;
+            if (yOffset + y < 0 || yOffset + y >= LED_HEIGHT) continue;
             
             if (column & (1 << y)) {
                 leds[XY(xOffset + x, yOffset + y)] = textColor;
@@ -252,11 +254,11 @@ void drawCharLarge(CRGB* leds, char c, int xOffset, int yOffset) {
     int charIndex = getCharIndex(c);
     
     for (int y = 0; y < 8; y++) {
-        if (yOffset + y < 0 || yOffset + y >= 16) continue;
+        if (yOffset + y < 0 || yOffset + y >= LED_HEIGHT) continue;
         
         uint8_t row = pgm_read_byte(&font8x8[charIndex * 8 + y]);
         for (int x = 0; x < 8; x++) {
-            if (xOffset + x < 0 || xOffset + x >= 16) continue;
+            if (xOffset + x < 0 || xOffset + x >= LED_WIDTH) continue;
             
             // Read bits from left to right to match font data orientation
             if (row & (1 << x)) {
@@ -297,7 +299,7 @@ void drawCharMono(CRGB* leds, unsigned char c, int xOffset, int yOffset, uint8_t
             int16_t y = yOffset + (int16_t)(yo + yy) * scale + 6; // Added vertical offset to center better
             
             // Check if the bit is set in the bitmap and if the pixel is within the display
-            if (bits & 0x80 && x >= 0 && x < 16 && y >= 0 && y < 16) {
+            if (bits & 0x80 && x >= 0 && x < LED_WIDTH && y >= 0 && y < LED_HEIGHT) {
                 leds[XY(x, y)] = textColor;
             }
             
@@ -345,7 +347,7 @@ void drawCharTest(CRGB* leds, char c, int xOffset, int yOffset, uint8_t size = 1
                 int16_t displayY = yOffset + (int16_t)(y * scale);
                 
                 // Check if the pixel is within the display
-                if (displayX >= 0 && displayX < 16 && displayY >= 0 && displayY < 16) {
+                if (displayX >= 0 && displayX < LED_WIDTH && displayY >= 0 && displayY < LED_HEIGHT) {
                     // Set color based on pixel value (brighter for higher values)
                     CRGB pixelColor = textColor;
                     pixelColor.nscale8_video(map(pixelValue, 1, 255, 64, 255));
@@ -369,184 +371,36 @@ void type(CRGB* leds) {
     unsigned long currentTime = millis();
     if (currentTime - lastUpdate > scrollDelay) {
         scrollPosition++;
-        if (scrollPosition >= totalWidth + 16) {
-            scrollPosition = -16;
+        if (scrollPosition >= totalWidth + LED_WIDTH) {
+            scrollPosition = -LED_WIDTH;
         }
         lastUpdate = currentTime;
     }
     
-    // Draw each character
+    // Draw each character, vertically centered (row 4 on a 16 high panel)
+    int yPos = (LED_HEIGHT - 8) / 2;
     for (size_t i = 0; i < currentText.length(); i++) {
-        int xPos = 16 - scrollPosition + (i * charWidth);
-        if (xPos > -charWidth && xPos < 16) {
+        int xPos = LED_WIDTH - scrollPosition + (i * charWidth);
+        if (xPos > -charWidth && xPos < LED_WIDTH) {
             if (useMonoFont) {
-                drawCharMono(leds, currentText[i], xPos, 4); // Draw using FreeMono font
+                drawCharMono(leds, currentText[i], xPos, yPos); // Draw using FreeMono font
             } else {
-                drawChar(leds, currentText[i], xPos, 4); // Draw using 5x7 font
+                drawChar(leds, currentText[i], xPos, yPos); // Draw using 5x7 font
             }
         }
     }
 }
 
-void setupTypePattern(AsyncWebServer* server) {
-    server->on("/type", HTTP_GET, [](AsyncWebServerRequest *request) {
-        String html = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-    <title>PixelBoard Text Display</title>
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <link rel="stylesheet" href="/style.css">
-</head>
-<body>
-    <div class="preview-container">
-        <div class="preview-grid" id="previewGrid"></div>
-    </div>
-    
-    <div class="controls" style="display:block;">
-        <div class="input-group">
-            <input type="text" id="text-input" placeholder="Enter text to display" value="PixelBoard">
-        </div>
-        
-        <div class="color-section">
-            <div class="color-section-label">Text Color</div>
-            <div class="color-selection" id="textColors">
-                <button class="color-btn active" style="background-color: #FFFFFF;" data-color="white">White</button>
-                <button class="color-btn" style="background-color: #FF0000;" data-color="red">Red</button>
-                <button class="color-btn" style="background-color: #00FF00;" data-color="green">Green</button>
-                <button class="color-btn" style="background-color: #0000FF;" data-color="blue">Blue</button>
-                <button class="color-btn" style="background-color: #FFFF00;" data-color="yellow">Yellow</button>
-                <button class="color-btn" style="background-color: #FF00FF;" data-color="purple">Purple</button>
-                <button class="color-btn" style="background-color: #00FFFF;" data-color="cyan">Cyan</button>
-            </div>
-        </div>
-
-        <div class="color-section">
-            <div class="color-section-label">Background Color</div>
-            <div class="color-selection" id="bgColors">
-                <button class="color-btn active" style="background-color: #000000;" data-color="black">Black</button>
-                <button class="color-btn" style="background-color: #FF0000;" data-color="red">Red</button>
-                <button class="color-btn" style="background-color: #00FF00;" data-color="green">Green</button>
-                <button class="color-btn" style="background-color: #0000FF;" data-color="blue">Blue</button>
-                <button class="color-btn" style="background-color: #FFFF00;" data-color="yellow">Yellow</button>
-                <button class="color-btn" style="background-color: #FF00FF;" data-color="purple">Purple</button>
-                <button class="color-btn" style="background-color: #00FFFF;" data-color="cyan">Cyan</button>
-            </div>
-        </div>
-        
-        <div class="font-selection">
-            <button class="font-btn active" data-size="small">Small Font</button>
-            <button class="font-btn" data-size="mono">Mono Font</button>
-        </div>
-    </div>
-
-    <script>
-        let previewUpdateInterval;
-        
-        // Create preview grid
-        function createPreviewGrid() {
-            const grid = document.getElementById('previewGrid');
-            for (let i = 0; i < 256; i++) {
-                const pixel = document.createElement('div');
-                pixel.className = 'preview-pixel';
-                pixel.id = 'pixel-' + i;
-                grid.appendChild(pixel);
-            }
-        }
-        
-        // Update the preview grid
-        function updatePreview() {
-            fetch('/pixelStatus')
-                .then(response => response.arrayBuffer())
-                .then(buffer => {
-                    const pixels = new Uint8Array(buffer);
-                    for (let i = 0; i < 256; i++) {
-                        const baseIndex = i * 3;
-                        const r = pixels[baseIndex];
-                        const g = pixels[baseIndex + 1];
-                        const b = pixels[baseIndex + 2];
-                        
-                        const pixelElement = document.getElementById('pixel-' + i);
-                        if (pixelElement) {
-                            pixelElement.style.backgroundColor = `rgb(${r},${g},${b})`;
-                        }
-                    }
-                })
-                .catch(error => console.error('Error updating preview:', error));
-        }
-        
-        document.addEventListener('DOMContentLoaded', function() {
-            let activeTextColor = 'white';
-            let activeBgColor = 'black';
-            let textInput = document.getElementById('text-input');
-            
-            // Set active color button for text colors
-            document.querySelectorAll('#textColors .color-btn').forEach(btn => {
-                btn.addEventListener('click', function() {
-                    document.querySelectorAll('#textColors .color-btn').forEach(b => b.classList.remove('active'));
-                    this.classList.add('active');
-                    activeTextColor = this.dataset.color;
-                    updateDisplay();
-                });
-            });
+// Apply a text update from /updatetext (called by the render task)
+void typeSetText(const char* text, CRGB color, CRGB background, const char* font) {
+    currentText = text;
+    textColor = color;
+    backgroundColor = background;
+    useMonoFont = (strcmp(font, "mono") == 0);
+}
 
-            // Set active color button for background colors
-            document.querySelectorAll('#bgColors .color-btn').forEach(btn => {
-                btn.addEventListener('click', function() {
-                    document.querySelectorAll('#bgColors .color-btn').forEach(b => b.classList.remove('active'));
-                    this.classList.add('active');
-                    activeBgColor = this.dataset.color;
-                    updateDisplay();
-                });
-            });
-            
-            // Function to update the text display
-            function updateDisplay() {
-                let text = textInput.value || 'PixelBoard';
-                let fontSize = document.querySelector('.font-btn.active').dataset.size;
-                
-                fetch(`/updatetext?text=${encodeURIComponent(text)}&textColor=${activeTextColor}&bgColor=${activeBgColor}&font=${fontSize}`)
-                    .then(response => response.text())
-                    .catch(error => console.error('Error:', error));
-            }
-            
-            // Set active font button
-            document.querySelectorAll('.font-btn').forEach(btn => {
-                btn.addEventListener('click', function() {
-                    document.querySelectorAll('.font-btn').forEach(b => b.classList.remove('active'));
-                    this.classList.add('active');
-                    updateDisplay();
-                });
-            });
-            
-            // Allow Enter key to submit
-            textInput.addEventListener('keypress', function(e) {
-                if (e.key === 'Enter') {
-                    updateDisplay();
-                }
-            });
-            
-            // Update when text input changes
-            textInput.addEventListener('input', updateDisplay);
-            
-            // Initialize
-            createPreviewGrid();
-            updatePreview();
-            previewUpdateInterval = setInterval(updatePreview, 100);
-        });
-        
-        // Clean up
-        window.addEventListener('unload', function() {
-            if (previewUpdateInterval) {
-                clearInterval(previewUpdateInterval);
-            }
-        });
-    </script>
-</body>
-</html>
-)rawliteral";
-        request->send(200, "text/html", html);
-    });
+void setupTypePattern(AsyncWebServer* server) {
+    webServeAsset(server, "/type", WEB_TYPE_HTML);
 
     // API endpoint to update the text
     server->on("/updatetext", HTTP_GET, [](AsyncWebServerRequest *request) {
@@ -559,30 +413,36 @@ void setupTypePattern(AsyncWebServer* server) {
             Serial.printf("Updating text: %s, Text Color: %s, Background Color: %s, Font: %s\n", 
                          text.c_str(), textColorStr.c_str(), bgColorStr.c_str(), fontSize.c_str());
             
-            // Update text
-            currentText = text;
-            
-            // Update text color
-            if (textColorStr == "red") textColor = CRGB::Red;
-            else if (textColorStr == "green") textColor = CRGB::Green;
-            else if (textColorStr == "blue") textColor = CRGB::Blue;
-            else if (textColorStr == "yellow") textColor = CRGB::Yellow;
-            else if (textColorStr == "purple") textColor = CRGB::Purple;
-            else if (textColorStr == "cyan") textColor = CRGB::Cyan;
-            else textColor = CRGB::White; // Default to white
+            // Parse text color
+            CRGB newTextColor;
+            if (textColorStr == "red") newTextColor = CRGB::Red;
+            else if (textColorStr == "green") newTextColor = CRGB::Green;
+            else if (textColorStr == "blue") newTextColor = CRGB::Blue;
+            else if (textColorStr == "yellow") newTextColor = CRGB::Yellow;
+            else if (textColorStr == "purple") newTextColor = CRGB::Purple;
+            else if (textColorStr == "cyan") newTextColor = CRGB::Cyan;
+            else newTextColor = CRGB::White; // Default to white
 
-            // Update background color
-            if (bgColorStr == "red") backgroundColor = CRGB::Red;
-            else if (bgColorStr == "green") backgroundColor = CRGB::Green;
-            else if (bgColorStr == "blue") backgroundColor = CRGB::Blue;
-            else if (bgColorStr == "yellow") backgroundColor = CRGB::Yellow;
-            else if (bgColorStr == "purple") backgroundColor = CRGB::Purple;
-            else if (bgColorStr == "cyan") backgroundColor = CRGB::Cyan;
-            else if (bgColorStr == "white") backgroundColor = CRGB::White;
-            else backgroundColor = CRGB::Black; // Default to black
+            // Parse background color
+            CRGB newBackground;
+            if (bgColorStr == "red") newBackground = CRGB::Red;
+            else if (bgColorStr == "green") newBackground = CRGB::Green;
+            else if (bgColorStr == "blue") newBackground = CRGB::Blue;
+            else if (bgColorStr == "yellow") newBackground = CRGB::Yellow;
+            else if (bgColorStr == "purple") newBackground = CRGB::Purple;
+            else if (bgColorStr == "cyan") newBackground = CRGB::Cyan;
+            else if (bgColorStr == "white") newBackground = CRGB::White;
+            else newBackground = CRGB::Black; // Default to black
             
-            // Update font size
-            useMonoFont = (fontSize == "mono");
+            // The scrolling text is read by the render task every frame, so
+            // hand the update over instead of reassigning the String here
+            if (!commandPostText(CMD_SET_TEXT, text.c_str(),
+                                 (newTextColor.r << 16) | (newTextColor.g << 8) | newTextColor.b,
+                                 (newBackground.r << 16) | (newBackground.g << 8) | newBackground.b,
+                                 fontSize.c_str())) {
+                request->send(503, "text/plain", "Busy");
+                return;
+            }
             
             request->send(200, "text/plain", "OK");
         } else {
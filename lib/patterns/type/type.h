@@ -37,5 +37,6 @@ extern const GFXfont FreeMono24pt7b PROGMEM;
 // Function declarations for the type pattern
 void type(CRGB* leds);
 void setupTypePattern(AsyncWebServer* server);
+void typeSetText(const char* text, CRGB color, CRGB background, const char* font);
 
 #endif 
\ No newline at end of file
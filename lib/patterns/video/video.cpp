@@ -1,11 +1,28 @@
 #include "video.h"
 #include <led_display.h>
+#include <patterns.h>
+#include <webassets.h>
 
-// Add the external reference to g_LEDs
-extern CRGB leds[];
+// Array to track pixel states (RGB values for each pixel). Written by the
+// web server's task and read by the render task, hence the lock.
+static CRGB pixelStates[LED_MAX_LEDS] = {0};
+static portMUX_TYPE s_pixelLock = portMUX_INITIALIZER_UNLOCKED;
 
-// Array to track pixel states (RGB values for each pixel)
-static CRGB pixelStates[NUM_LEDS] = {0};
+// Frames streamed over /videows. Each binary message is a 4-byte header,
+// a 16-bit little-endian sequence number, then the frame's width and
+// height, followed by width * height RGB triples row by row. A frame
+// older than the last one shown, e.g. a stale one arriving late, is
+// dropped.
+// One client streams at a time, since its messages are put back together
+// in s_wsFrame; others are closed as they connect and the page falls back
+// to POST /videoframe.
+#define VIDEO_WS_HEADER 4
+static AsyncWebSocket s_videoSocket("/videows");
+static uint32_t s_streamClient = 0;     // id of the client streaming, 0 for none
+static uint8_t s_wsFrame[VIDEO_WS_HEADER + LED_MAX_LEDS * 3];
+static uint16_t s_lastSequence = 0;
+static bool s_haveSequence = false;
+static uint32_t s_framesReceived = 0, s_framesStale = 0, s_framesInvalid = 0;
 
 // Frame rate control
 static unsigned long lastFrameTime = 0;
@@ -13,500 +30,87 @@ int frameDelay = 1000 / 30;  // default 30 fps
 
 void video(CRGB* leds) {
     // Update all pixels from our state array
-    for(int i = 0; i < NUM_LEDS; i++) {
-        leds[i] = pixelStates[i];
-    }
-    FastLED.show();
-    FastLED.delay(33); // ~30fps
+    portENTER_CRITICAL(&s_pixelLock);
+    memcpy(leds, pixelStates, NUM_LEDS * sizeof(CRGB));
+    portEXIT_CRITICAL(&s_pixelLock);
+    setFrameDelay(33); // ~30fps
 }
 
-void setupVideoPlayer(AsyncWebServer* server) {
-    server->on("/video", HTTP_GET, [](AsyncWebServerRequest *request) {
-        String html = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-    <title>PixelBoard Video Player</title>
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <style>
-        body {
-            font-family: Arial, sans-serif;
-            margin: 0;
-            padding: 20px;
-            background-color: #282c34;
-            color: #ffffff;
-            min-height: 100vh;
-            display: flex;
-            flex-direction: column;
-            align-items: center;
-        }
-        .control-panel {
-            width: min(80%, 600px);
-            margin-bottom: 20px;
-            padding: 20px;
-            background: #3b3f47;
-            border-radius: 10px;
-            border: 1px solid #61dafb;
-        }
-        .section-title {
-            font-size: 18px;
-            color: #61dafb;
-            margin: 0 0 15px 0;
-        }
-        .controls-layout {
-            display: flex;
-            gap: 20px;
-        }
-        .controls-left {
-            flex: 1;
-        }
-        .preview-box {
-            width: 120px;
-            height: 120px;
-            background: #282c34;
-            border-radius: 4px;
-            border: 1px solid #61dafb;
-            overflow: hidden;
-        }
-        .preview-box video {
-            width: 100%;
-            height: 100%;
-            object-fit: cover;
-        }
-        .slider-row {
-            display: flex;
-            align-items: center;
-            gap: 10px;
-            margin-bottom: 15px;
-        }
-        .slider-row label {
-            width: 70px;
-            color: #ffffff;
-        }
-        .slider-row input[type="range"] {
-            flex: 1;
-            -webkit-appearance: none;
-            height: 4px;
-            background: #282c34;
-            border-radius: 2px;
-            outline: none;
-        }
-        .slider-row input[type="range"]::-webkit-slider-thumb {
-            -webkit-appearance: none;
-            width: 16px;
-            height: 16px;
-            border-radius: 50%;
-            background: #61dafb;
-            cursor: pointer;
-        }
-        .slider-row .value {
-            width: 60px;
-            text-align: right;
-            color: #61dafb;
-        }
-        .progress-row {
-            margin: 15px 0;
-            padding: 15px 0;
-            border-top: 1px solid #61dafb;
-            border-bottom: 1px solid #61dafb;
-        }
-        .progress-row input[type="range"] {
-            width: 100%;
-            -webkit-appearance: none;
-            height: 4px;
-            background: #282c34;
-            border-radius: 2px;
-            outline: none;
-        }
-        .progress-row input[type="range"]::-webkit-slider-thumb {
-            -webkit-appearance: none;
-            width: 16px;
-            height: 16px;
-            border-radius: 50%;
-            background: #61dafb;
-            cursor: pointer;
-        }
-        .button-row {
-            display: flex;
-            gap: 10px;
-            margin-top: 15px;
-            padding-top: 15px;
-            border-top: 1px solid #61dafb;
-        }
-        .action-btn {
-            background: #282c34;
-            color: #61dafb;
-            border: 1px solid #61dafb;
-            padding: 8px 16px;
-            border-radius: 4px;
-            cursor: pointer;
-            font-weight: normal;
-            font-size: 14px;
-            transition: all 0.2s;
-        }
-        .action-btn:hover:not(:disabled) {
-            background: #61dafb;
-            color: #282c34;
-        }
-        .action-btn:disabled {
-            opacity: 0.5;
-            cursor: not-allowed;
-        }
-        .grid {
-            display: grid;
-            grid-template-columns: repeat(16, 1fr);
-            gap: 2px;
-            background: #3b3f47;
-            padding: 20px;
-            border-radius: 10px;
-            aspect-ratio: 1;
-            width: min(80%, 600px);
+// Copy a row-major RGB frame onto the display, clipped to its size
+static void storeFrame(const uint8_t* rgb, uint16_t width, uint16_t height) {
+    portENTER_CRITICAL(&s_pixelLock);
+    for (uint16_t y = 0; y < height && y < LED_HEIGHT; y++) {
+        for (uint16_t x = 0; x < width && x < LED_WIDTH; x++) {
+            const uint8_t* p = rgb + (y * width + x) * 3;
+            pixelStates[XY(x, y)] = CRGB(p[0], p[1], p[2]);
         }
-        .pixel {
-            aspect-ratio: 1;
-            background: #282c34;
-            border-radius: 2px;
-        }
-        #videoInput {
-            display: none;
-        }
-        #preview-canvas {
-            display: none;
-        }
-    </style>
-</head>
-<body>
-    <div class="control-panel">
-        <div class="section-title">Playback Controls</div>
-        <div class="controls-layout">
-            <div class="controls-left">
-                <div class="progress-row">
-                    <input type="range" id="progressSlider" min="0" max="100" value="0" step="0.1">
-                </div>
-                <div class="slider-row">
-                    <label>Speed:</label>
-                    <input type="range" id="speedSlider" min="1" max="30" value="10">
-                    <span class="value" id="fpsValue">10 FPS</span>
-                </div>
-                <div class="slider-row">
-                    <label>Zoom:</label>
-                    <input type="range" id="zoomSlider" min="50" max="300" value="100">
-                    <span class="value" id="zoomValue">100%</span>
-                </div>
-                <div class="slider-row">
-                    <label>Pan X:</label>
-                    <input type="range" id="panXSlider" min="-64" max="64" value="0">
-                    <span class="value" id="panXValue">0px</span>
-                </div>
-                <div class="slider-row">
-                    <label>Pan Y:</label>
-                    <input type="range" id="panYSlider" min="-64" max="64" value="0">
-                    <span class="value" id="panYValue">0px</span>
-                </div>
-            </div>
-            <div class="preview-box">
-                <video id="video"></video>
-            </div>
-        </div>
-        <div class="button-row">
-            <button id="playBtn" class="action-btn" disabled>Play</button>
-            <button id="pauseBtn" class="action-btn" disabled>Pause</button>
-            <button id="stopBtn" class="action-btn" disabled>Stop</button>
-            <button id="clearBtn" class="action-btn">Clear Board</button>
-            <label class="action-btn" for="videoInput">Choose Video File</label>
-            <input type="file" id="videoInput" accept="video/*">
-        </div>
-    </div>
+    }
+    portEXIT_CRITICAL(&s_pixelLock);
+    requestFrame();
+}
 
-    <canvas id="preview-canvas" width="160" height="160"></canvas>
-    <div class="grid" id="pixelGrid"></div>
+static void handleStreamedFrame(const uint8_t* data, size_t len) {
+    if (len < VIDEO_WS_HEADER || len != VIDEO_WS_HEADER + data[2] * data[3] * 3u) {
+        s_framesInvalid++;
+        return;
+    }
+    uint16_t sequence = data[0] | data[1] << 8;
+    if (s_haveSequence && (int16_t)(sequence - s_lastSequence) <= 0) {
+        s_framesStale++;
+        return;
+    }
+    s_lastSequence = sequence;
+    s_haveSequence = true;
+    s_framesReceived++;
+    storeFrame(data + VIDEO_WS_HEADER, data[2], data[3]);
+}
 
-    <script>
-        // DOM elements
-        const videoInput = document.getElementById('videoInput');
-        const video = document.getElementById('video');
-        const canvas = document.getElementById('preview-canvas');
-        const ctx = canvas.getContext('2d', { willReadFrequently: true });
-        const pixelGrid = document.getElementById('pixelGrid');
-        const playBtn = document.getElementById('playBtn');
-        const pauseBtn = document.getElementById('pauseBtn');
-        const stopBtn = document.getElementById('stopBtn');
-        const clearBtn = document.getElementById('clearBtn');
-        const speedSlider = document.getElementById('speedSlider');
-        const fpsValue = document.getElementById('fpsValue');
-        const zoomSlider = document.getElementById('zoomSlider');
-        const zoomValue = document.getElementById('zoomValue');
-        const panXSlider = document.getElementById('panXSlider');
-        const panXValue = document.getElementById('panXValue');
-        const panYSlider = document.getElementById('panYSlider');
-        const panYValue = document.getElementById('panYValue');
-        const progressSlider = document.getElementById('progressSlider');
-        
-        // Variables
-        let isPlaying = false;
-        let animationId = null;
-        let fps = 10;
-        let lastFrameTime = 0;
-        let zoomLevel = 100;
-        let panX = 0;
-        let panY = 0;
-        let isDraggingProgress = false;
-        
-        // Create 16x16 grid for preview
-        for (let y = 0; y < 16; y++) {
-            for (let x = 0; x < 16; x++) {
-                const pixel = document.createElement('div');
-                pixel.className = 'pixel';
-                pixel.dataset.x = x;
-                pixel.dataset.y = y;
-                pixelGrid.appendChild(pixel);
-            }
-        }
-        
-        // Handle video file selection
-        videoInput.addEventListener('change', function(e) {
-            const file = e.target.files[0];
-            if (!file) return;
-            
-            const url = URL.createObjectURL(file);
-            video.src = url;
-            
-            video.onloadedmetadata = function() {
-                playBtn.disabled = false;
-                progressSlider.max = video.duration;
-                updatePixelboardPreview();
-            };
-        });
-        
-        // Progress slider
-        progressSlider.addEventListener('mousedown', () => {
-            isDraggingProgress = true;
-            if (isPlaying) {
-                video.pause();
-                cancelAnimationFrame(animationId);
-            }
-        });
-        
-        progressSlider.addEventListener('mouseup', () => {
-            isDraggingProgress = false;
-            if (isPlaying) {
-                video.play();
-                animateVideo();
-            }
-        });
-        
-        progressSlider.addEventListener('input', function() {
-            video.currentTime = parseFloat(this.value);
-            updatePixelboardPreview();
-        });
-        
-        // Update progress bar during playback
-        video.addEventListener('timeupdate', function() {
-            if (!isDraggingProgress) {
-                progressSlider.value = video.currentTime;
-            }
-        });
-        
-        // Speed slider
-        speedSlider.addEventListener('input', function() {
-            fps = parseInt(this.value);
-            fpsValue.textContent = `${fps} FPS`;
-        });
-        
-        // Zoom slider
-        zoomSlider.addEventListener('input', function() {
-            zoomLevel = parseInt(this.value);
-            zoomValue.textContent = `${zoomLevel}%`;
-            updatePixelboardPreview();
-        });
-        
-        // Pan X slider
-        panXSlider.addEventListener('input', function() {
-            panX = parseInt(this.value);
-            panXValue.textContent = `${panX}px`;
-            updatePixelboardPreview();
-        });
-        
-        // Pan Y slider
-        panYSlider.addEventListener('input', function() {
-            panY = parseInt(this.value);
-            panYValue.textContent = `${panY}px`;
-            updatePixelboardPreview();
-        });
-        
-        // Play button
-        playBtn.addEventListener('click', function() {
-            if (isPlaying) return;
-            
-            fetch('/videocontrol?action=play&fps=' + fps)
-                .then(response => response.text())
-                .then(text => {
-                    console.log("Playing video");
-                });
-            
-            isPlaying = true;
-            playBtn.disabled = true;
-            pauseBtn.disabled = false;
-            stopBtn.disabled = false;
-            
-            video.play();
-            animateVideo();
-        });
-        
-        // Pause button
-        pauseBtn.addEventListener('click', function() {
-            if (!isPlaying) return;
-            
-            fetch('/videocontrol?action=pause')
-                .then(response => response.text())
-                .then(text => {
-                    console.log("Paused video");
-                });
-            
-            isPlaying = false;
-            playBtn.disabled = false;
-            pauseBtn.disabled = true;
-            
-            video.pause();
-            cancelAnimationFrame(animationId);
-        });
-        
-        // Stop button
-        stopBtn.addEventListener('click', function() {
-            fetch('/videocontrol?action=stop')
-                .then(response => response.text())
-                .then(text => {
-                    console.log("Stopped video");
-                });
-            
-            isPlaying = false;
-            playBtn.disabled = false;
-            pauseBtn.disabled = true;
-            stopBtn.disabled = true;
-            
-            video.pause();
-            video.currentTime = 0;
-            cancelAnimationFrame(animationId);
-            updatePixelboardPreview();
-        });
-        
-        // Clear button
-        clearBtn.addEventListener('click', function() {
-            fetch('/videocontrol?action=clear')
-                .then(response => response.text())
-                .then(text => {
-                    console.log("Cleared board");
-                    const pixels = document.getElementsByClassName('pixel');
-                    for(let pixel of pixels) {
-                        pixel.style.backgroundColor = '#282c34';
-                    }
-                });
-        });
-        
-        // Function to animate video frames
-        function animateVideo() {
-            const now = performance.now();
-            const elapsed = now - lastFrameTime;
-            
-            if (elapsed > 1000 / fps) {
-                lastFrameTime = now;
-                updatePixelboardPreview();
-                sendFrameToDevice();
-            }
-            
-            if (isPlaying) {
-                animationId = requestAnimationFrame(animateVideo);
-            }
-        }
-        
-        // Update the preview with current video frame
-        function updatePixelboardPreview() {
-            ctx.clearRect(0, 0, canvas.width, canvas.height);
-            
-            const videoAspect = video.videoWidth / video.videoHeight;
-            const canvasAspect = canvas.width / canvas.height;
-            
-            let baseWidth, baseHeight, baseX, baseY;
-            
-            // Calculate base dimensions to fill canvas while maintaining aspect ratio
-            if (videoAspect > canvasAspect) {
-                baseWidth = canvas.width;
-                baseHeight = canvas.width / videoAspect;
-                baseX = 0;
-                baseY = (canvas.height - baseHeight) / 2;
-            } else {
-                baseHeight = canvas.height;
-                baseWidth = canvas.height * videoAspect;
-                baseX = (canvas.width - baseWidth) / 2;
-                baseY = 0;
-            }
-            
-            // Apply zoom from center
-            const zoomFactor = zoomLevel / 100;
-            const zoomedWidth = baseWidth * zoomFactor;
-            const zoomedHeight = baseHeight * zoomFactor;
-            
-            // Center the zoomed image and apply pixel-based pan
-            const centerOffsetX = (zoomedWidth - baseWidth) / 2;
-            const centerOffsetY = (zoomedHeight - baseHeight) / 2;
-            
-            // Calculate final position with pan
-            const adjustedX = baseX - centerOffsetX + panX;
-            const adjustedY = baseY - centerOffsetY + panY;
-            
-            try {
-                ctx.drawImage(video, adjustedX, adjustedY, zoomedWidth, zoomedHeight);
-                
-                const pixelSize = 10;
-                for(let y = 0; y < 16; y++) {
-                    for(let x = 0; x < 16; x++) {
-                        const imageData = ctx.getImageData(x * pixelSize + 5, y * pixelSize + 5, 1, 1).data;
-                        const pixel = document.querySelector(`.pixel[data-x="${x}"][data-y="${y}"]`);
-                        pixel.style.backgroundColor = `rgb(${imageData[0]},${imageData[1]},${imageData[2]})`;
-                    }
-                }
-            } catch (e) {
-                console.error("Error updating preview:", e);
-            }
-        }
-        
-        // Send current frame to device
-        function sendFrameToDevice() {
-            const pixelSize = 10;
-            const buffer = new Uint8Array(16 * 16 * 3); // 256 pixels * 3 bytes (RGB)
-            
-            for(let y = 0; y < 16; y++) {
-                for(let x = 0; x < 16; x++) {
-                    // For even rows, get pixels from right to left (serpentine pattern)
-                    const sampleX = (y % 2 === 0) ? (15 - x) : x;
-                    const imageData = ctx.getImageData(sampleX * pixelSize + 5, y * pixelSize + 5, 1, 1).data;
-                    
-                    // Calculate buffer index: (y * 16 + x) * 3 for RGB values
-                    const bufferIndex = (y * 16 + x) * 3;
-                    buffer[bufferIndex] = imageData[0];     // R
-                    buffer[bufferIndex + 1] = imageData[1]; // G
-                    buffer[bufferIndex + 2] = imageData[2]; // B
-                }
-            }
-            
-            // Send binary data
-            fetch('/videoframe', {
-                method: 'POST',
-                headers: {
-                    'Content-Type': 'application/octet-stream'
-                },
-                body: buffer
-            });
-        }
-        
-        // Update grid when video is seeked
-        video.addEventListener('seeked', updatePixelboardPreview);
-    </script>
-</body>
-</html>
-)rawliteral";
-        request->send(200, "text/html", html);
-    });
+// Runs on the web server's task. Browsers send a message as one WebSocket
+// frame, but TCP may hand it over in pieces; they're put back together in
+// s_wsFrame.
+static void onVideoSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type,
+                               void* arg, uint8_t* data, size_t len) {
+    if (type == WS_EVT_CONNECT) {
+        if (s_streamClient && server->client(s_streamClient)) {
+            client->close();
+            return;
+        }
+        // A new stream starts its sequence afresh
+        s_streamClient = client->id();
+        s_haveSequence = false;
+        return;
+    }
+    if (type == WS_EVT_DISCONNECT && client->id() == s_streamClient) {
+        s_streamClient = 0;
+    }
+    if (type != WS_EVT_DATA || client->id() != s_streamClient) {
+        return;
+    }
+    AwsFrameInfo* info = (AwsFrameInfo*)arg;
+    if (info->opcode != WS_BINARY || info->num != 0 || info->len > sizeof(s_wsFrame)) {
+        if (info->index == 0) s_framesInvalid++;
+        return;
+    }
+    memcpy(s_wsFrame + info->index, data, len);
+    if (info->final && info->index + len == info->len) {
+        handleStreamedFrame(s_wsFrame, info->len);
+    }
+}
+
+void videoLoop() {
+    static uint32_t lastCleanup = 0;
+    uint32_t now = millis();
+    if (now - lastCleanup >= 1000) {
+        s_videoSocket.cleanupClients(1);
+        lastCleanup = now;
+    }
+}
+
+void setupVideoPlayer(AsyncWebServer* server) {
+    s_videoSocket.onEvent(onVideoSocketEvent);
+    server->addHandler(&s_videoSocket);
+
+    webServeAsset(server, "/video", WEB_VIDEO_HTML);
 
     // Handle video control commands
     server->on("/videocontrol", HTTP_GET, [](AsyncWebServerRequest *request) {
@@ -534,11 +138,21 @@ void setupVideoPlayer(AsyncWebServer* server) {
                 request->send(200, "text/plain", "Stopped");
             }
             else if (action == "clear") {
+                portENTER_CRITICAL(&s_pixelLock);
                 fill_solid(pixelStates, NUM_LEDS, CRGB::Black);
-                fill_solid(leds, NUM_LEDS, CRGB::Black);
-                FastLED.show();
+                portEXIT_CRITICAL(&s_pixelLock);
+                requestFrame();
                 request->send(200, "text/plain", "Cleared");
             }
+            else if (action == "stats") {
+                // Streaming counters: frames shown, dropped as stale, malformed
+                char json[128];
+                snprintf(json, sizeof(json),
+                         "{\"received\":%u,\"stale\":%u,\"invalid\":%u,\"sequence\":%u,\"clients\":%u}",
+                         (unsigned)s_framesReceived, (unsigned)s_framesStale, (unsigned)s_framesInvalid,
+                         s_lastSequence, (unsigned)s_videoSocket.count());
+                request->send(200, "application/json", json);
+            }
             else {
                 request->send(400, "text/plain", "Invalid action");
             }
@@ -553,13 +167,8 @@ void setupVideoPlayer(AsyncWebServer* server) {
     },
     NULL,
     [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
-        if (len == 768) { // 256 pixels * 3 bytes (RGB)
-            for (size_t i = 0; i < 256; i++) {
-                const size_t dataIndex = i * 3;
-                pixelStates[i] = CRGB(data[dataIndex], data[dataIndex + 1], data[dataIndex + 2]);
-                leds[i] = pixelStates[i];
-            }
-            FastLED.show();
+        if (len == 768) { // 16x16 pixels * 3 bytes (RGB), row by row
+            storeFrame(data, 16, 16);
         }
     });
 }
\ No newline at end of file
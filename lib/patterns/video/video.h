@@ -6,5 +6,8 @@
 #include <led_display.h>
 void video(CRGB* leds);
 void setupVideoPlayer(AsyncWebServer* server);
+// Called from wifiLoop(): frees the /videows clients that have gone. The
+// page reconnects every second while its socket is down, so they add up.
+void videoLoop();
 
 #endif // VIDEO_PATTERN_H 
\ No newline at end of file
@@ -0,0 +1,316 @@
+#include "preview.h"
+#include <led_display.h>
+
+// The last PREVIEW_HISTORY previews, sequence s in slot s % PREVIEW_HISTORY.
+// Sequence 1 is the black screen the board starts with, so a client
+// holding 0 always gets a keyframe.
+static uint8_t s_history[PREVIEW_HISTORY][PREVIEW_BYTES];
+static uint32_t s_sequence = 1;
+static PreviewStats s_stats = {};
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Encodings of preview s_sequence made so far, each holding a reference
+static PreviewBuffer* s_cache[PREVIEW_ENCODINGS];
+
+static const uint16_t s_encodedSize[PREVIEW_ENCODINGS] = {
+  PREVIEW_BYTES, PREVIEW_ICO_BYTES, PREVIEW_HEADER, PREVIEW_MAX_MESSAGE, PREVIEW_MAX_MESSAGE
+};
+
+// previewUpdate()'s own, touched by its task only
+static CRGB s_leds[LED_MAX_LEDS];
+static uint8_t s_sampled[PREVIEW_BYTES];
+static uint32_t s_lastFrame = 0;
+
+static inline void put32(uint8_t* p, uint32_t v) {
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+}
+
+static inline uint32_t get32(const uint8_t* p) {
+  return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline const uint8_t* historyAt(uint32_t sequence) {
+  return s_history[sequence % PREVIEW_HISTORY];
+}
+
+// Whether preview `sequence` is still in the history
+static inline bool inHistory(uint32_t sequence) {
+  return sequence != 0 && sequence <= s_sequence && s_sequence - sequence < PREVIEW_HISTORY;
+}
+
+void previewSample(const CRGB* leds, uint8_t* rgb) {
+  for (int y = 0; y < PREVIEW_SIZE; y++) {
+    for (int x = 0; x < PREVIEW_SIZE; x++) {
+      const CRGB& c = leds[XY(x * LED_WIDTH / PREVIEW_SIZE, y * LED_HEIGHT / PREVIEW_SIZE)];
+      *rgb++ = c.r;
+      *rgb++ = c.g;
+      *rgb++ = c.b;
+    }
+  }
+}
+
+size_t previewEncodeRuns(const uint8_t* from, const uint8_t* to, uint8_t* out, size_t max) {
+  size_t len = 0;
+  uint16_t i = 0;
+  while (i < PREVIEW_PIXELS) {
+    if (!memcmp(from + i * 3, to + i * 3, 3)) {
+      i++;
+      continue;
+    }
+    // A run ends at the first unchanged pixel: restarting costs 2 bytes,
+    // carrying one unchanged pixel along costs 3
+    uint16_t end = i + 1;
+    while (end < PREVIEW_PIXELS && end - i < 255 && memcmp(from + end * 3, to + end * 3, 3)) {
+      end++;
+    }
+    uint8_t count = end - i;
+    if (len + 2 + count * 3 > max) {
+      return 0;
+    }
+    out[len++] = i;
+    out[len++] = count;
+    memcpy(out + len, to + i * 3, count * 3);
+    len += count * 3;
+    i = end;
+  }
+  return len;
+}
+
+void previewEncodeIco(const uint8_t* rgb, uint8_t* out) {
+  // ICO header: reserved, type 1 (icon), one image
+  static const uint8_t header[6] = {0, 0, 1, 0, 1, 0};
+  memcpy(out, header, 6);
+  out += 6;
+
+  // Directory entry: 16x16, no palette, 1 plane, 32 bits per pixel, then
+  // the image's size and offset
+  static const uint8_t entry[8] = {PREVIEW_SIZE, PREVIEW_SIZE, 0, 0, 1, 0, 32, 0};
+  memcpy(out, entry, 8);
+  put32(out + 8, PREVIEW_ICO_BYTES - 22);
+  put32(out + 12, 22);
+  out += 16;
+
+  // BITMAPINFOHEADER. The height counts the (absent) AND mask as well,
+  // hence twice the width.
+  memset(out, 0, 40);
+  out[0] = 40;
+  out[4] = PREVIEW_SIZE;
+  out[8] = PREVIEW_SIZE * 2;
+  out[12] = 1;     // planes
+  out[14] = 32;    // bits per pixel
+  out += 40;
+
+  // Pixels bottom-up, as BGRA
+  for (int y = PREVIEW_SIZE - 1; y >= 0; y--) {
+    const uint8_t* p = rgb + y * PREVIEW_SIZE * 3;
+    for (int x = 0; x < PREVIEW_SIZE; x++, p += 3) {
+      *out++ = p[2];
+      *out++ = p[1];
+      *out++ = p[0];
+      *out++ = 255;
+    }
+  }
+}
+
+uint32_t previewUpdate() {
+  uint32_t frame = led_frame_number();
+  if (frame == s_lastFrame) {
+    return s_sequence;
+  }
+  s_lastFrame = led_snapshot(s_leds);
+  previewSample(s_leds, s_sampled);
+
+  PreviewBuffer* stale[PREVIEW_ENCODINGS] = {};
+  portENTER_CRITICAL(&s_lock);
+  if (memcmp(s_sampled, historyAt(s_sequence), PREVIEW_BYTES)) {
+    s_sequence++;
+    memcpy(s_history[s_sequence % PREVIEW_HISTORY], s_sampled, PREVIEW_BYTES);
+    memcpy(stale, s_cache, sizeof(stale));
+    memset(s_cache, 0, sizeof(s_cache));
+  }
+  uint32_t sequence = s_sequence;
+  portEXIT_CRITICAL(&s_lock);
+
+  // The cache's references; responses still sending keep theirs
+  for (PreviewBuffer* buffer : stale) {
+    previewRelease(buffer);
+  }
+  return sequence;
+}
+
+// Encode the current preview, under the lock. `out` has room for
+// s_encodedSize[encoding] bytes; returns the length used.
+static size_t encode(PreviewEncoding encoding, uint8_t* out) {
+  const uint8_t* current = historyAt(s_sequence);
+  switch (encoding) {
+    case PREVIEW_RAW:
+      memcpy(out, current, PREVIEW_BYTES);
+      return PREVIEW_BYTES;
+    case PREVIEW_ICO:
+      previewEncodeIco(current, out);
+      return PREVIEW_ICO_BYTES;
+    default:
+      break;
+  }
+
+  put32(out + 1, s_sequence);
+  if (encoding == PREVIEW_MSG_UNCHANGED) {
+    out[0] = PREVIEW_UNCHANGED;
+    return PREVIEW_HEADER;
+  }
+  if (encoding == PREVIEW_MSG_NEXT && inHistory(s_sequence - 1)) {
+    size_t runs = previewEncodeRuns(historyAt(s_sequence - 1), current, out + PREVIEW_DELTA_HEADER,
+                                    PREVIEW_MAX_MESSAGE - PREVIEW_DELTA_HEADER);
+    if (runs) {
+      out[0] = PREVIEW_DELTA;
+      put32(out + PREVIEW_HEADER, s_sequence - 1);
+      return PREVIEW_DELTA_HEADER + runs;
+    }
+  }
+  out[0] = PREVIEW_KEYFRAME;
+  memcpy(out + PREVIEW_HEADER, current, PREVIEW_BYTES);
+  return PREVIEW_MAX_MESSAGE;
+}
+
+static PreviewBuffer* allocate(size_t len) {
+  PreviewBuffer* buffer = (PreviewBuffer*)malloc(sizeof(PreviewBuffer) + len);
+  if (buffer) {
+    buffer->refs = 1;
+  }
+  return buffer;
+}
+
+const PreviewBuffer* previewAcquire(PreviewEncoding encoding) {
+  portENTER_CRITICAL(&s_lock);
+  PreviewBuffer* cached = s_cache[encoding];
+  if (cached) {
+    cached->refs++;
+    s_stats.hits[encoding]++;
+  }
+  portEXIT_CRITICAL(&s_lock);
+  if (cached) {
+    return cached;
+  }
+
+  // Allocate outside the lock, then encode whatever is current by then.
+  // If another task got there first, use its buffer instead.
+  PreviewBuffer* buffer = allocate(s_encodedSize[encoding]);
+  if (!buffer) {
+    return nullptr;
+  }
+  portENTER_CRITICAL(&s_lock);
+  cached = s_cache[encoding];
+  if (cached) {
+    cached->refs++;
+    s_stats.hits[encoding]++;
+  } else {
+    buffer->sequence = s_sequence;
+    buffer->len = encode(encoding, buffer->data);
+    buffer->refs = 2;   // the cache's and the caller's
+    s_cache[encoding] = buffer;
+    s_stats.liveBuffers++;
+    s_stats.misses[encoding]++;
+  }
+  portEXIT_CRITICAL(&s_lock);
+  if (cached) {
+    free(buffer);
+    return cached;
+  }
+  return buffer;
+}
+
+// A delta from an older preview, made for this request only
+static const PreviewBuffer* olderDelta(uint32_t since) {
+  PreviewBuffer* buffer = allocate(PREVIEW_MAX_MESSAGE);
+  if (!buffer) {
+    return nullptr;
+  }
+  portENTER_CRITICAL(&s_lock);
+  size_t runs = 0;
+  if (inHistory(since)) {
+    runs = previewEncodeRuns(historyAt(since), historyAt(s_sequence), buffer->data + PREVIEW_DELTA_HEADER,
+                             PREVIEW_MAX_MESSAGE - PREVIEW_DELTA_HEADER);
+  }
+  if (runs) {
+    buffer->sequence = s_sequence;
+    buffer->len = PREVIEW_DELTA_HEADER + runs;
+    buffer->data[0] = PREVIEW_DELTA;
+    put32(buffer->data + 1, s_sequence);
+    put32(buffer->data + PREVIEW_HEADER, since);
+    s_stats.liveBuffers++;
+    s_stats.uncached++;
+  }
+  portEXIT_CRITICAL(&s_lock);
+  if (!runs) {
+    // Moved on meanwhile, or too many changes; a keyframe it is
+    free(buffer);
+    return previewAcquire(PREVIEW_MSG_KEYFRAME);
+  }
+  return buffer;
+}
+
+const PreviewBuffer* previewMessage(uint32_t since) {
+  const PreviewBuffer* buffer;
+  for (;;) {
+    portENTER_CRITICAL(&s_lock);
+    uint32_t sequence = s_sequence;
+    bool older = since + 1 < sequence && inHistory(since);
+    portEXIT_CRITICAL(&s_lock);
+
+    if (since == sequence) {
+      buffer = previewAcquire(PREVIEW_MSG_UNCHANGED);
+    } else if (since != 0 && since + 1 == sequence) {
+      buffer = previewAcquire(PREVIEW_MSG_NEXT);
+    } else if (older) {
+      buffer = olderDelta(since);
+    } else {
+      buffer = previewAcquire(PREVIEW_MSG_KEYFRAME);
+    }
+    // A new preview may have come in meanwhile, and the cached message
+    // be for that one; "unchanged" or a delta from another base would
+    // then be wrong, so look again
+    if (!buffer || buffer->data[0] == PREVIEW_KEYFRAME ||
+        (buffer->data[0] == PREVIEW_UNCHANGED ? buffer->sequence : get32(buffer->data + PREVIEW_HEADER)) == since) {
+      break;
+    }
+    previewRelease(buffer);
+  }
+
+  if (buffer) {
+    portENTER_CRITICAL(&s_lock);
+    switch (buffer->data[0]) {
+      case PREVIEW_UNCHANGED: s_stats.unchanged++; break;
+      case PREVIEW_KEYFRAME:  s_stats.keyframes++; break;
+      case PREVIEW_DELTA:     s_stats.deltas++; break;
+    }
+    s_stats.bytes += buffer->len;
+    portEXIT_CRITICAL(&s_lock);
+  }
+  return buffer;
+}
+
+void previewRelease(const PreviewBuffer* buffer) {
+  if (!buffer) {
+    return;
+  }
+  PreviewBuffer* b = const_cast<PreviewBuffer*>(buffer);
+  portENTER_CRITICAL(&s_lock);
+  bool last = --b->refs == 0;
+  if (last) {
+    s_stats.liveBuffers--;
+  }
+  portEXIT_CRITICAL(&s_lock);
+  if (last) {
+    free(b);
+  }
+}
+
+void previewGetStats(PreviewStats* stats) {
+  portENTER_CRITICAL(&s_lock);
+  *stats = s_stats;
+  stats->sequence = s_sequence;
+  portEXIT_CRITICAL(&s_lock);
+}
@@ -0,0 +1,103 @@
+#ifndef PREVIEW_H
+#define PREVIEW_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+// The web pages' preview of the display: the last presented frame sampled
+// down to 16x16 RGB, and sent as changes against a frame the page already
+// has.
+//
+// Every preview that differs from the one before gets the next sequence
+// number. The numbering only moves when something changed, so a static
+// pattern (Draw, Clock between seconds, Sleep) keeps its number however
+// many frames are rendered. A client names the last sequence it holds
+// (0 for none) and gets one message back:
+//
+//   [type u8][sequence u32 LE]                  PREVIEW_UNCHANGED
+//   [type u8][sequence u32 LE][768 RGB bytes]   PREVIEW_KEYFRAME
+//   [type u8][sequence u32 LE][base u32 LE]     PREVIEW_DELTA, followed by
+//       runs of [first pixel u8][count u8][count RGB triples]
+//
+// `sequence` is what the client holds once it has applied the message.
+// A delta only applies on top of `base`. Deltas are made against any of
+// the last PREVIEW_HISTORY previews; older clients, and changes that
+// would take more bytes than a keyframe, get a keyframe.
+
+// Every encoding of a preview is made at most once: the first request for
+// it after the preview changes encodes it into a PreviewBuffer, which is
+// cached and handed to every later request until the next change. Holders
+// keep a reference while they send, so a buffer is never rewritten under
+// a response still in flight; it is freed when the cache has moved on and
+// the last holder has released it.
+
+#define PREVIEW_SIZE        16
+#define PREVIEW_PIXELS      (PREVIEW_SIZE * PREVIEW_SIZE)
+#define PREVIEW_BYTES       (PREVIEW_PIXELS * 3)
+#define PREVIEW_HEADER      5
+#define PREVIEW_DELTA_HEADER 9
+#define PREVIEW_MAX_MESSAGE (PREVIEW_HEADER + PREVIEW_BYTES)
+#define PREVIEW_ICO_BYTES   (6 + 16 + 40 + PREVIEW_PIXELS * 4)
+#define PREVIEW_HISTORY     8
+
+enum PreviewMessageType : uint8_t {
+  PREVIEW_UNCHANGED = 0,
+  PREVIEW_KEYFRAME = 1,
+  PREVIEW_DELTA = 2
+};
+
+// What the cache holds, one of each for the current preview
+enum PreviewEncoding : uint8_t {
+  PREVIEW_RAW,            // PREVIEW_BYTES of RGB, for plain /pixelStatus
+  PREVIEW_ICO,            // 32-bit 16x16 icon, for /favicon.ico
+  PREVIEW_MSG_UNCHANGED,  // message for a client that is up to date
+  PREVIEW_MSG_NEXT,       // ...one preview behind: a delta, or a keyframe if smaller
+  PREVIEW_MSG_KEYFRAME,   // ...holding nothing, or too far behind
+  PREVIEW_ENCODINGS
+};
+
+// Immutable once handed out
+struct PreviewBuffer {
+  uint32_t sequence;      // preview it encodes
+  uint16_t refs;
+  uint16_t len;
+  uint8_t data[];
+};
+
+struct PreviewStats {
+  uint32_t sequence;      // current preview
+  uint32_t unchanged;     // messages of each type handed out
+  uint32_t keyframes;
+  uint32_t deltas;
+  uint32_t bytes;         // in those messages
+  uint32_t hits[PREVIEW_ENCODINGS];    // served from the cache
+  uint32_t misses[PREVIEW_ENCODINGS];  // had to be encoded
+  uint32_t uncached;      // deltas against older previews, encoded per request
+  uint16_t liveBuffers;   // cached or held
+};
+
+// Sample a full frame down to the preview, PREVIEW_BYTES of RGB in panel
+// order
+void previewSample(const CRGB* leds, uint8_t* rgb);
+
+// The runs that turn preview `from` into `to`, written to `out`. Returns
+// their length, or 0 if they would take more than `max` bytes.
+size_t previewEncodeRuns(const uint8_t* from, const uint8_t* to, uint8_t* out, size_t max);
+
+// Preview `rgb` as an ICO file, PREVIEW_ICO_BYTES long
+void previewEncodeIco(const uint8_t* rgb, uint8_t* out);
+
+// Take in the last presented frame if it's new. Only call this from one
+// task (wifiLoop()); returns the current sequence.
+uint32_t previewUpdate();
+
+// Any task. The current preview in `encoding`, or the message for a
+// client that holds preview `since`. Each returns a reference the caller
+// must hand back with previewRelease(), or nullptr if out of memory.
+const PreviewBuffer* previewAcquire(PreviewEncoding encoding);
+const PreviewBuffer* previewMessage(uint32_t since);
+void previewRelease(const PreviewBuffer* buffer);
+
+void previewGetStats(PreviewStats* stats);
+
+#endif // PREVIEW_H
@@ -0,0 +1,344 @@
+#include "sprites.h"
+
+// Header field offsets
+#define HDR_FRAMES   5
+#define HDR_PALETTE  6
+#define HDR_BITS     7
+#define HDR_SIZE     8
+#define FRAME_HDR    5
+
+static inline uint16_t read16(const uint8_t* p) {
+  return pgm_read_byte(p) | (pgm_read_byte(p + 1) << 8);
+}
+
+static inline uint16_t paletteSize(const uint8_t* sheet) {
+  return pgm_read_byte(sheet + HDR_PALETTE) + 1;
+}
+
+// Offset of the first frame header
+static inline uint16_t firstFrame(const uint8_t* sheet) {
+  return HDR_SIZE + paletteSize(sheet) * 3;
+}
+
+static inline uint8_t frameType(const uint8_t* sheet, uint16_t offset) {
+  return pgm_read_byte(sheet + offset + 2);
+}
+
+uint8_t spriteFrameCount(const uint8_t* sheet) {
+  return pgm_read_byte(sheet + HDR_FRAMES);
+}
+
+// Byte offset of the header following the frame at `offset`
+static inline uint16_t nextFrame(const uint8_t* sheet, uint16_t offset) {
+  return offset + FRAME_HDR + read16(sheet + offset + 3);
+}
+
+static uint16_t frameOffset(const uint8_t* sheet, uint8_t frame) {
+  uint16_t offset = firstFrame(sheet);
+  for (uint8_t i = 0; i < frame; i++) {
+    offset = nextFrame(sheet, offset);
+  }
+  return offset;
+}
+
+// Everything needed to turn tokens into pixels on the panel
+struct Blit {
+  const uint8_t* palette;
+  uint16_t colors;       // palette entries
+  uint8_t width;
+  uint16_t total;        // width * height
+  uint8_t bits;
+  uint8_t tokenBytes;
+  int x0, y0;
+  uint32_t color, replacement;
+  CRGB* leds;
+};
+
+// Set up from a sheet header. `header` may be in flash or, for streamed
+// sheets, a RAM copy; the palette follows it directly in either case.
+static void blitBegin(Blit* b, const uint8_t* header, CRGB* leds,
+                      int x0, int y0, uint32_t color, uint32_t replacement) {
+  b->palette = header + HDR_SIZE;
+  b->colors = pgm_read_byte(header + HDR_PALETTE) + 1;
+  b->width = pgm_read_byte(header + 3);
+  b->total = b->width * pgm_read_byte(header + 4);
+  b->bits = pgm_read_byte(header + HDR_BITS);
+  b->tokenBytes = b->bits == 8 ? 2 : 1;
+  b->x0 = x0;
+  b->y0 = y0;
+  b->color = color;
+  b->replacement = replacement;
+  b->leds = leds;
+}
+
+// Read one run token, returning its length and palette index
+static inline const uint8_t* readToken(const Blit* b, const uint8_t* p, uint16_t* run, uint8_t* index) {
+  if (b->bits == 8) {
+    *run = pgm_read_byte(p) + 1;
+    *index = pgm_read_byte(p + 1);
+    return p + 2;
+  }
+  uint8_t token = pgm_read_byte(p);
+  *index = token >> (8 - b->bits);
+  *run = (token & ((1 << (8 - b->bits)) - 1)) + 1;
+  return p + 1;
+}
+
+// Paint `run` pixels of palette entry `index` starting at sprite pixel `pos`.
+// Indices past the palette (only in a damaged or hand-made sheet) get its
+// last entry.
+static uint16_t paint(const Blit* b, uint16_t pos, uint16_t run, uint8_t index) {
+  if (index >= b->colors) {
+    index = b->colors - 1;
+  }
+  const uint8_t* rgb = b->palette + index * 3;
+  CRGB c(pgm_read_byte(rgb), pgm_read_byte(rgb + 1), pgm_read_byte(rgb + 2));
+  if (b->color != b->replacement && ((uint32_t)c.r << 16 | c.g << 8 | c.b) == b->color) {
+    c = CRGB(b->replacement);
+  }
+
+  for (; run > 0 && pos < b->total; run--, pos++) {
+    int x = b->x0 + pos % b->width;
+    int y = b->y0 + pos / b->width;
+    if (x >= 0 && x < LED_WIDTH && y >= 0 && y < LED_HEIGHT) {
+      b->leds[XY(x, y)] = c;
+    }
+  }
+  return pos;
+}
+
+// Decode one key or delta frame payload. Delta frames are applied on top
+// of whatever is in leds, which must be the previous frame. A token cut
+// short by the end of the payload is dropped.
+static void decodePayload(const Blit* b, uint8_t type, const uint8_t* p, const uint8_t* end) {
+  uint16_t pos = 0;
+  uint16_t run;
+  uint8_t index;
+  if (type == SPRITE_FRAME_DELTA) {
+    while (p < end && pos < b->total) {
+      uint8_t skip = pgm_read_byte(p++);
+      pos += skip;
+      if (skip == 255) continue;   // long gap, another skip byte follows
+      if (end - p < b->tokenBytes) break;
+      p = readToken(b, p, &run, &index);
+      pos = paint(b, pos, run, index);
+    }
+  } else {
+    while (end - p >= b->tokenBytes && pos < b->total) {
+      p = readToken(b, p, &run, &index);
+      pos = paint(b, pos, run, index);
+    }
+  }
+}
+
+// Draw the frame whose header starts at `offset`
+static void drawAt(const Blit* b, const uint8_t* sheet, uint16_t offset) {
+  const uint8_t* frame = sheet + offset;
+  uint8_t type = pgm_read_byte(frame + 2);
+  if (type == SPRITE_FRAME_REPEAT) {
+    frame = sheet + frameOffset(sheet, pgm_read_byte(frame + FRAME_HDR));
+    type = SPRITE_FRAME_KEY;
+  }
+  const uint8_t* p = frame + FRAME_HDR;
+  decodePayload(b, type, p, p + read16(frame + 3));
+}
+
+uint16_t spriteDrawFrame(const uint8_t* sheet, uint8_t frame, CRGB* leds,
+                         int x0, int y0, uint32_t color, uint32_t replacement) {
+  Blit b;
+  blitBegin(&b, sheet, leds, x0, y0, color, replacement);
+
+  // A delta frame can only be rebuilt from the last full frame before it
+  uint16_t offset = firstFrame(sheet);
+  uint16_t restart = offset;
+  uint8_t restartFrame = 0;
+  for (uint8_t i = 0; i < frame; i++) {
+    offset = nextFrame(sheet, offset);
+    if (frameType(sheet, offset) != SPRITE_FRAME_DELTA) {
+      restart = offset;
+      restartFrame = i + 1;
+    }
+  }
+
+  for (uint8_t i = restartFrame; i <= frame; i++) {
+    drawAt(&b, sheet, restart);
+    restart = nextFrame(sheet, restart);
+  }
+  return read16(sheet + offset);
+}
+
+void spritePlayerStart(SpritePlayer* player, const uint8_t* sheet) {
+  player->sheet = sheet;
+  player->frame = 0;
+  player->offset = firstFrame(sheet);
+}
+
+uint16_t spritePlayerNext(SpritePlayer* player, CRGB* leds) {
+  const uint8_t* sheet = player->sheet;
+  Blit b;
+  blitBegin(&b, sheet, leds, 0, 0, 0, 0);
+  drawAt(&b, sheet, player->offset);
+  uint16_t duration = read16(sheet + player->offset);
+
+  if (++player->frame >= spriteFrameCount(sheet)) {
+    player->frame = 0;
+    player->offset = firstFrame(sheet);
+  } else {
+    player->offset = nextFrame(sheet, player->offset);
+  }
+  return duration;
+}
+
+// ---------------------------------------------------------------------------
+// Streaming from the filesystem
+// ---------------------------------------------------------------------------
+
+// Read the header of the frame at `offset` and its payload into the buffer
+static bool streamLoad(SpriteStream* s, uint32_t offset) {
+  uint8_t hdr[FRAME_HDR];
+  if (!s->file.seek(offset) || s->file.read(hdr, FRAME_HDR) != FRAME_HDR) {
+    return false;
+  }
+  uint16_t length = hdr[3] | (hdr[4] << 8);
+  if (length > s->bufferSize) {
+    uint8_t* grown = (uint8_t*)realloc(s->buffer, length);
+    if (!grown) return false;
+    s->buffer = grown;
+    s->bufferSize = length;
+  }
+  s->duration = hdr[0] | (hdr[1] << 8);
+  s->type = hdr[2];
+  s->length = length;
+  return s->file.read(s->buffer, length) == length;
+}
+
+// Load the next frame to show, resolving repeats to their key frame
+static bool streamPrefetch(SpriteStream* s) {
+  if (!streamLoad(s, s->offsets[s->frame])) {
+    return false;
+  }
+  if (s->type == SPRITE_FRAME_REPEAT) {
+    uint16_t duration = s->duration;
+    uint8_t target = s->buffer[0];
+    if (target >= s->frameCount || !streamLoad(s, s->offsets[target])) {
+      return false;
+    }
+    s->duration = duration;
+    s->type = SPRITE_FRAME_KEY;
+  }
+  return true;
+}
+
+// Index widths the token format has room for
+static inline bool validBits(uint8_t bits) {
+  return (bits >= 1 && bits <= 4) || bits == 8;
+}
+
+bool spriteStreamOpen(SpriteStream* s, fs::FS& fs, const char* path) {
+  spriteStreamClose(s);
+  s->frame = 0;
+  s->file = fs.open(path, "r");
+  if (!s->file) {
+    return false;
+  }
+
+  // Files come from uploads, so nothing in them is taken on trust: the
+  // decoder relies on the index width, frame lengths and repeat targets
+  // checked here
+  uint8_t hdr[HDR_SIZE];
+  if (s->file.read(hdr, HDR_SIZE) != HDR_SIZE || hdr[0] != 'P' || hdr[1] != 'X' ||
+      hdr[2] != SPRITE_VERSION || hdr[3] == 0 || hdr[4] == 0 || hdr[HDR_FRAMES] == 0 ||
+      !validBits(hdr[HDR_BITS])) {
+    spriteStreamClose(s);
+    return false;
+  }
+
+  // Keep the header and palette in RAM, the frames stay on the filesystem
+  uint16_t paletteBytes = (hdr[HDR_PALETTE] + 1) * 3;
+  s->frameCount = hdr[HDR_FRAMES];
+  s->header = (uint8_t*)malloc(HDR_SIZE + paletteBytes);
+  s->offsets = (uint32_t*)malloc(s->frameCount * sizeof(uint32_t));
+  if (!s->header || !s->offsets) {
+    spriteStreamClose(s);
+    return false;
+  }
+  memcpy(s->header, hdr, HDR_SIZE);
+  if (s->file.read(s->header + HDR_SIZE, paletteBytes) != paletteBytes) {
+    spriteStreamClose(s);
+    return false;
+  }
+
+  // Index the frames once so loops and repeats can seek straight to them.
+  // Every frame has to fit in the file, and a repeat has to name a key
+  // frame before it.
+  uint32_t size = s->file.size();
+  uint32_t offset = HDR_SIZE + paletteBytes;
+  uint8_t types[256];
+  for (uint8_t i = 0; i < s->frameCount; i++) {
+    uint8_t fh[FRAME_HDR + 1];
+    if (!s->file.seek(offset) || s->file.read(fh, FRAME_HDR) != FRAME_HDR) {
+      spriteStreamClose(s);
+      return false;
+    }
+    uint16_t length = fh[3] | (fh[4] << 8);
+    bool ok = fh[2] <= SPRITE_FRAME_DELTA && offset + FRAME_HDR + length <= size;
+    if (ok && fh[2] == SPRITE_FRAME_REPEAT) {
+      ok = length >= 1 && s->file.read(fh + FRAME_HDR, 1) == 1 &&
+           fh[FRAME_HDR] < i && types[fh[FRAME_HDR]] == SPRITE_FRAME_KEY;
+    }
+    if (!ok) {
+      spriteStreamClose(s);
+      return false;
+    }
+    types[i] = fh[2];
+    s->offsets[i] = offset;
+    offset += FRAME_HDR + length;
+  }
+
+  if (!streamPrefetch(s)) {
+    spriteStreamClose(s);
+    return false;
+  }
+  return true;
+}
+
+uint16_t spriteStreamNext(SpriteStream* s, CRGB* leds) {
+  if (!s->header) {
+    return 0;
+  }
+
+  Blit b;
+  blitBegin(&b, s->header, leds, 0, 0, 0, 0);
+  decodePayload(&b, s->type, s->buffer, s->buffer + s->length);
+  uint16_t duration = s->duration;
+
+  // Read ahead now, so the flash access happens while this frame is shown
+  // rather than when the next one is due
+  s->frame = (s->frame + 1) % s->frameCount;
+  if (!streamPrefetch(s)) {
+    Serial.println("Sprite stream read failed, stopping");
+    spriteStreamClose(s);
+  }
+  return duration;
+}
+
+void spriteStreamClose(SpriteStream* s) {
+  if (s->file) {
+    s->file.close();
+  }
+  free(s->header);
+  free(s->offsets);
+  free(s->buffer);
+  s->header = nullptr;
+  s->offsets = nullptr;
+  s->buffer = nullptr;
+  s->bufferSize = 0;
+}
+
+size_t spriteStreamMemory(const SpriteStream* s) {
+  if (!s->header) {
+    return 0;
+  }
+  return HDR_SIZE + (s->header[HDR_PALETTE] + 1) * 3 +
+         s->frameCount * sizeof(uint32_t) + s->bufferSize;
+}
@@ -0,0 +1,97 @@
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <FastLED.h>
+#include <FS.h>
+#include <led_display.h>
+
+// Compact sprite sheets for animated patterns.
+//
+// A sheet holds a shared palette and a list of run-length encoded frames,
+// so a 16x16 frame with a handful of colors takes well under 100 bytes
+// instead of the 1KB of a `const long[256]` table. All values are
+// little-endian:
+//
+//   'P' 'X'             magic
+//   uint8  version      (SPRITE_VERSION)
+//   uint8  width, height
+//   uint8  frameCount
+//   uint8  paletteSize - 1
+//   uint8  indexBits    1..4, or 8
+//   uint8  palette[paletteSize][3]   (r, g, b)
+//   frameCount x {
+//     uint16 durationMs  (passed to setFrameDelay by the player)
+//     uint8  frameType   (SPRITE_FRAME_KEY, _REPEAT or _DELTA)
+//     uint16 length      (bytes of payload that follow)
+//     payload
+//   }
+//
+// A key frame is a run of tokens covering width*height pixels in row-major
+// order (x, y as seen on the panel, not LED wiring order). With indexBits
+// of 4 or fewer a token is one byte, the palette index in the top bits and
+// run length - 1 in the rest; with 8 it is two bytes, run length - 1 then
+// the index. A repeat frame's payload is one byte, the number of an earlier
+// key frame to show again, so loops like 1-2-3-2 store each image once.
+//
+// A delta frame only lists the pixels that changed since the previous
+// frame, as pairs of a skip byte (pixels left alone; 255 means skip 255
+// and read another skip byte) followed by one run token. Drawing it costs
+// time in proportion to what changed, but it has to be drawn on top of the
+// previous frame: SpritePlayer guarantees that as long as nothing else
+// draws into leds between its frames, and spriteDrawFrame() rebuilds from
+// the nearest earlier key frame when asked for a delta frame.
+//
+// Sheets are produced from PNGs by src/utils/sprite_compiler.py.
+
+#define SPRITE_VERSION       1
+#define SPRITE_FRAME_KEY     0
+#define SPRITE_FRAME_REPEAT  1
+#define SPRITE_FRAME_DELTA   2
+
+// Sequential playback of a sheet, looping at the end
+struct SpritePlayer {
+  const uint8_t* sheet;
+  uint8_t frame;          // index of the next frame to draw
+  uint16_t offset;        // byte offset of that frame's header
+};
+
+uint8_t spriteFrameCount(const uint8_t* sheet);
+
+// Draw one frame at (x0, y0). Palette entries equal to `color` are drawn as
+// `replacement` (same convention as the old loadArray()). Returns the
+// frame's duration in ms.
+uint16_t spriteDrawFrame(const uint8_t* sheet, uint8_t frame, CRGB* leds,
+                         int x0 = 0, int y0 = 0,
+                         uint32_t color = 0, uint32_t replacement = 0);
+
+// Restart at frame 0 (always a full frame). Call this whenever leds may
+// have been drawn over, e.g. from the pattern's begin hook.
+void spritePlayerStart(SpritePlayer* player, const uint8_t* sheet);
+uint16_t spritePlayerNext(SpritePlayer* player, CRGB* leds);
+
+// Playback of a sheet stored as a file (the compiler's .pxs output), so
+// animations can be uploaded without reflashing. Only the header, palette,
+// a frame index and the frame about to be shown are held in RAM; the next
+// frame is read ahead as soon as the current one has been drawn.
+struct SpriteStream {
+  fs::File file;
+  uint8_t* header = nullptr;    // sheet header + palette
+  uint32_t* offsets = nullptr;  // file offset of every frame header
+  uint8_t* buffer = nullptr;    // payload of the frame about to be shown
+  uint16_t bufferSize = 0;
+  uint16_t length = 0;          // bytes of that payload
+  uint16_t duration = 0;
+  uint8_t type = 0;
+  uint8_t frame = 0;
+  uint8_t frameCount = 0;
+};
+
+// Fails, leaving the stream closed, for a file that isn't a well formed
+// sheet: unsupported index width, a frame running past the end of the
+// file, or a repeat of anything but an earlier key frame
+bool spriteStreamOpen(SpriteStream* stream, fs::FS& fs, const char* path);
+uint16_t spriteStreamNext(SpriteStream* stream, CRGB* leds);  // 0 once closed
+void spriteStreamClose(SpriteStream* stream);
+size_t spriteStreamMemory(const SpriteStream* stream);
+
+#endif // SPRITES_H
@@ -0,0 +1,19 @@
+#include "webassets.h"
+
+void webServeAsset(AsyncWebServer* server, const char* uri, const WebAsset& asset) {
+  const WebAsset* a = &asset;
+  server->on(uri, HTTP_GET, [a](AsyncWebServerRequest *request) {
+    if (request->hasHeader("If-None-Match") && request->getHeader("If-None-Match")->value() == a->etag) {
+      AsyncWebServerResponse *response = request->beginResponse(304);
+      response->addHeader("ETag", a->etag);
+      response->addHeader("Cache-Control", WEB_ASSET_CACHE_CONTROL);
+      request->send(response);
+      return;
+    }
+    AsyncWebServerResponse *response = request->beginResponse_P(200, a->contentType, a->data, a->length);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", a->etag);
+    response->addHeader("Cache-Control", WEB_ASSET_CACHE_CONTROL);
+    request->send(response);
+  });
+}
@@ -0,0 +1,32 @@
+#ifndef WEBASSETS_H
+#define WEBASSETS_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+// The web UI's pages and scripts. They are written as plain files in web/
+// and tools/build_web.py minifies and gzips them into flash at build time,
+// one WebAsset each in web_pages.h (WEB_INDEX_HTML for web/index.html and
+// so on). Serving one costs no heap and no copying: the response streams
+// the gzipped bytes from flash as they are, and browsers inflate them.
+//
+// The pages are static; anything that changes at runtime (the pattern
+// list, brightness, speed) they fetch from the device's JSON endpoints.
+
+struct WebAsset {
+  const char* contentType;
+  const uint8_t* data;    // gzipped, in flash
+  size_t length;
+  const char* etag;       // quoted hash of the data
+};
+
+#include "web_pages.h"
+
+// Browsers keep the assets for a day and then revalidate with the ETag,
+// which costs a 304 unless a firmware update changed the file
+#define WEB_ASSET_CACHE_CONTROL "public, max-age=86400"
+
+// Serve `asset` at `uri`
+void webServeAsset(AsyncWebServer* server, const char* uri, const WebAsset& asset);
+
+#endif // WEBASSETS_H
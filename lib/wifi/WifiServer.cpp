@@ -19,8 +19,13 @@
 #include "type/type.h"         // For setupTypePattern
 #include "snake/snake.h"       // For setupSnakePattern
 #include "clock/clock.h"       // For setupClockPattern
+#include "animation/animation.h"  // For setupAnimationPattern
 #include "SPIFFS.h"
 #include "tetris/tetris.h"    // Add Tetris setup declaration
+#include <commands.h>          // Settings are handed to the renderer as commands
+#include <metrics.h>           // Frame timing for /metrics
+#include <preview.h>           // Preview encoding for /pixelStatus and /previewws
+#include <webassets.h>         // The pages and scripts in web/, gzipped into flash
 
 #if ENABLE_MICROPHONE
 #include "audio/audio.h"      // Add audio pattern header
@@ -67,11 +72,15 @@ static void startAccessPoint();
 static void connectToWiFi();
 static void setupMDNS();
 static void setupHomePage();
+static void setupStateHandler();
 static void setupPatternHandler();
 static void setupBrightnessHandler();
 static void setupSpeedHandler();
 static void setupPixelStatusHandler();
+static void setupPreviewHandlers();
 static void setupFaviconHandler();  // Add favicon handler declaration
+static void setupGeometryHandler();
+static void setupMetricsHandler();
 static void startServer();
 static void savePreviewInterval(int interval);
 
@@ -82,6 +91,7 @@ void setupTypePattern(AsyncWebServer* server);
 void setupSnakePattern(AsyncWebServer* server);
 void setupTetrisPattern(AsyncWebServer* server);  // Add Tetris setup declaration
 void setupClockPattern(AsyncWebServer* server);      // Add Clock setup declaration
+void setupAnimationPattern(AsyncWebServer* server);
 void setupAudioPattern(AsyncWebServer* server);  // Add audio pattern setup
 
 // -------------------------------------------------------------------
@@ -272,429 +282,45 @@ static void setupMDNS() {
 }
 
 // -------------------------------------------------------------------
-// Home page route ("/") with improved styling for patterns
+// Home page route ("/"), a static page (web/index.html) that builds its
+// pattern grid and settings from /state
 // -------------------------------------------------------------------
 static void setupHomePage() {
-  server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
-    String html = R"rawliteral(
-      <!DOCTYPE html>
-      <html>
-      <head>
-        <meta charset="UTF-8">
-        <title>PixelBoard Control</title>
-        <script type="text/javascript" src="/static/libgif.js"></script>
-        <meta name="viewport" content="width=device-width, initial-scale=1.0">
-        <link rel="stylesheet" href="/style.css">
-        <link rel="icon" type="image/x-icon" href="/favicon.ico">
-      </head>
-      <body>
-        <div class="mobile-tabs">
-          <div class="tab-buttons">
-            <button class="tab-button active" data-tab="pattern">Pattern</button>
-            <button class="tab-button" data-tab="preview">Preview</button>
-          </div>
-        </div>
-        <div class="page-layout">
-          <div class="controls-panel">
-            <div class="resize-handle"></div>
-            <div class="main-controls">
-              <h1>PixelBoard Control</h1>
-              <div class="pattern-grid">
-    )rawliteral";
+  webServeAsset(&server, "/", WEB_INDEX_HTML);
+}
 
-    // Add pattern options as grid items
-    for (size_t i = 0; i < PATTERN_COUNT; i++) {
-      html += "<div class=\"pattern-item" + String(i == g_current_pattern_number ? " selected" : "") + 
-              "\" onclick=\"updatePattern(" + String(i) + ")\">" +
-              "<div class=\"pattern-icon\">" + String(g_patternList[i].icon) + "</div>" +
-              "<div class=\"pattern-name\">" + String(g_patternList[i].name) + "</div>" +
-              "</div>";
+// JSON string literal for `text`; names and icons are plain UTF-8, only
+// quotes and backslashes need escaping
+static String jsonString(const char* text) {
+  String s = "\"";
+  for (const char* c = text; *c; c++) {
+    if (*c == '"' || *c == '\\') {
+      s += '\\';
     }
+    s += *c;
+  }
+  return s + "\"";
+}
 
-    html += R"rawliteral(
-              </div>
-            </div>
-          </div>
-          <div class="preview-panel" id="previewPanel">
-            <!-- Preview content will be dynamically inserted here -->
-          </div>
-        </div>
-
-        <!-- Settings Modal -->
-        <button class="settings-button" onclick="openModal()">⚙️</button>
-        <div class="modal" id="settingsModal">
-          <div class="modal-content">
-            <div class="modal-header">
-              <h2>Settings & Preview Controls</h2>
-              <button class="close-modal" onclick="closeModal()">&times;</button>
-            </div>
-            
-            <div class="modal-section">
-              <h3>Pattern Controls</h3>
-              <div class="slider-container">
-                <label for="brightness">Brightness: <span id="brightnessValue">)rawliteral";
-    
-    html += String(g_Brightness);
-    
-    html += R"rawliteral(</span></label>
-                <input type="range" min="0" max="255" value=")rawliteral";
-    
-    html += String(g_Brightness);
-    
-    html += R"rawliteral(" class="slider" id="brightness" oninput="updateBrightness(this.value)">
-              </div>
-
-              <div class="slider-container">
-                <label for="speed">Speed: <span id="speedValue">)rawliteral";
-    
-    html += String(g_Speed);
-    
-    html += R"rawliteral(</span></label>
-                <input type="range" min="0" max="255" value=")rawliteral";
-    
-    html += String(g_Speed);
-    
-    html += R"rawliteral(" class="slider" id="speed" oninput="updateSpeed(this.value)">
-              </div>
-            </div>
-
-            <div class="modal-section">
-              <h3>Preview Settings</h3>
-              <div class="slider-container">
-                <label for="previewSpeed">Update Interval: <span id="previewSpeedValue">)rawliteral";
-
-    html += String(g_PreviewInterval) + "ms";
-
-    html += R"rawliteral(</span></label>
-                <input type="range" min="10" max="10000" value=")rawliteral";
-
-    html += String(g_PreviewInterval);
-
-    html += R"rawliteral(" class="slider" id="previewSpeed" oninput="updatePreviewSpeed(this.value)">
-                <div class="value-display">
-                  <span style="float: left">10ms</span>
-                  <span style="float: right">10s</span>
-                </div>
-              </div>
-              <div class="preview-status">
-                Status: <span id="previewStatus">Running</span><br>
-                Last Update: <span id="lastUpdate">Never</span>
-              </div>
-            </div>
-          </div>
-        </div>
-
-        <script>
-          let previewUpdateInterval;
-          let isPaused = false;
-          let currentUpdateInterval = )rawliteral";
-
-    html += String(g_PreviewInterval);
-
-    html += R"rawliteral(; // Use server-side interval
-          let isUpdating = false; // Flag to prevent concurrent requests
-          let currentTab = 'pattern';
-
-          // Mobile tab handling
-          document.querySelectorAll('.tab-button').forEach(button => {
-            button.addEventListener('click', () => {
-              // Update active tab button
-              document.querySelectorAll('.tab-button').forEach(btn => btn.classList.remove('active'));
-              button.classList.add('active');
-              
-              // Update current tab
-              currentTab = button.dataset.tab;
-              
-              // Show/hide panels based on selected tab
-              const controlsPanel = document.querySelector('.controls-panel');
-              const previewPanel = document.querySelector('.preview-panel');
-              
-              if (currentTab === 'pattern') {
-                controlsPanel.style.display = 'flex';
-                previewPanel.style.display = 'none';
-              } else {
-                controlsPanel.style.display = 'none';
-                previewPanel.style.display = 'flex';
-              }
-            });
-          });
-
-          function formatTime(date) {
-            return date.toLocaleTimeString();
-          }
-
-          function formatInterval(ms) {
-            return ms >= 1000 ? (ms / 1000).toFixed(1) + 's' : ms + 'ms';
-          }
-
-          function updateLastUpdateTime() {
-            document.getElementById('lastUpdate').textContent = formatTime(new Date());
-          }
-
-          function updatePreviewSpeed(value) {
-            currentUpdateInterval = parseInt(value);
-            document.getElementById('previewSpeedValue').textContent = formatInterval(currentUpdateInterval);
-            
-            // Save the new interval to the server
-            fetch('/previewInterval?value=' + value)
-              .then(response => response.text())
-              .then(data => console.log('Preview interval updated:', data))
-              .catch(error => console.error('Error:', error));
-            
-            // Restart interval with new timing if running
-            if (!isPaused) {
-              startPreviewInterval();
-            }
-          }
-
-          function refreshPreview() {
-            // If already updating, skip this update
-            if (isUpdating) {
-              console.log('Skipping update - previous request still in progress');
-              return;
-            }
-
-            isUpdating = true;
-            document.getElementById('previewStatus').textContent = 'Updating...';
-
-            fetch('/pixelStatus')
-              .then(response => response.arrayBuffer())  // Get as binary data
-              .then(buffer => {
-                const pixels = new Uint8Array(buffer);
-                for (let i = 0; i < 256; i++) {
-                  const baseIndex = i * 3;
-                  const r = pixels[baseIndex];
-                  const g = pixels[baseIndex + 1];
-                  const b = pixels[baseIndex + 2];
-                  
-                  const pixelElement = document.getElementById('pixel-' + i);
-                  if (pixelElement) {
-                    pixelElement.style.backgroundColor = `rgb(${r},${g},${b})`;
-                  }
-                }
-                updateLastUpdateTime();
-                document.getElementById('previewStatus').textContent = 'Running';
-              })
-              .catch(error => {
-                console.error('Error updating preview:', error);
-                document.getElementById('previewStatus').textContent = 'Error';
-              })
-              .finally(() => {
-                isUpdating = false;
-              });
-          }
-
-          function togglePreview() {
-            const pauseButton = document.getElementById('pauseButton');
-            const statusElement = document.getElementById('previewStatus');
-            
-            isPaused = !isPaused;
-            
-            if (isPaused) {
-              clearInterval(previewUpdateInterval);
-              pauseButton.textContent = 'Resume';
-              statusElement.textContent = 'Paused';
-            } else {
-              startPreviewInterval();
-              pauseButton.textContent = 'Pause';
-              statusElement.textContent = 'Running';
-              // Only refresh immediately if we're not already updating
-              if (!isUpdating) {
-                refreshPreview();
-              }
-            }
-          }
-
-          function startPreviewInterval() {
-            if (previewUpdateInterval) {
-              clearInterval(previewUpdateInterval);
-            }
-            previewUpdateInterval = setInterval(refreshPreview, currentUpdateInterval);
-          }
-
-          function startPreviewUpdates() {
-            // Create the initial grid
-            const previewPanel = document.getElementById('previewPanel');
-            const grid = document.createElement('div');
-            grid.className = 'preview-grid';
-            
-            // Create grid using row/column layout
-            for (let i = 0; i < 256; i++) {
-              const pixel = document.createElement('div');
-              pixel.className = 'preview-pixel';
-              pixel.id = 'pixel-' + i;
-              grid.appendChild(pixel);
-            }
-            previewPanel.appendChild(grid);
-
-            // Initial update
-            refreshPreview();
-
-            // Start interval if not paused
-            if (!isPaused) {
-              startPreviewInterval();
-            }
-          }
-
-          function updateBrightness(value) {
-            document.getElementById('brightnessValue').textContent = value;
-            fetch('/brightness?value=' + value)
-              .then(response => response.text())
-              .then(data => console.log('Brightness updated:', data))
-              .catch(error => console.error('Error:', error));
-          }
-
-          function updateSpeed(value) {
-            document.getElementById('speedValue').textContent = value;
-            fetch('/speed?value=' + value)
-              .then(response => response.text())
-              .then(data => console.log('Speed updated:', data))
-              .catch(error => console.error('Error:', error));
-          }
-
-          function updatePattern(value) {
-            // Update selected pattern in grid
-            document.querySelectorAll('.pattern-item').forEach(item => {
-              item.classList.remove('selected');
-            });
-            document.querySelector(`.pattern-item[onclick*="updatePattern(${value})"]`).classList.add('selected');
-            
-            const previewPanel = document.getElementById('previewPanel');
-            
-            // Clear existing content
-            previewPanel.innerHTML = '';
-            
-            // Clear any existing interval
-            if (previewUpdateInterval) {
-                clearInterval(previewUpdateInterval);
-            }
-            
-            // Get pattern name from selected item
-            const selectedName = document.querySelector(`.pattern-item[onclick*="updatePattern(${value})"] .pattern-name`).textContent;
-            
-            // Handle special patterns
-            if (selectedName.toLowerCase().includes('draw')) {
-                // Load draw interface
-                const iframe = document.createElement('iframe');
-                iframe.src = '/draw';
-                previewPanel.appendChild(iframe);
-            } else if (selectedName.toLowerCase().includes('video')) {
-                // Load video interface
-                const iframe = document.createElement('iframe');
-                iframe.src = '/video';
-                previewPanel.appendChild(iframe);
-            } else if (selectedName.toLowerCase().includes('text') || selectedName.toLowerCase().includes('type')) {
-                // Load text/type interface
-                const iframe = document.createElement('iframe');
-                iframe.src = '/type';
-                previewPanel.appendChild(iframe);
-            } else if (selectedName.toLowerCase().includes('snake')) {
-                // Load snake game interface
-                const iframe = document.createElement('iframe');
-                iframe.src = '/snake';
-                previewPanel.appendChild(iframe);
-            } else if (selectedName.toLowerCase().includes('tetris')) {
-                // Load tetris game interface
-                const iframe = document.createElement('iframe');
-                iframe.src = '/tetris';
-                previewPanel.appendChild(iframe);
-            } else if (selectedName.toLowerCase().includes('clock')) {
-                // Load clock game interface
-                const iframe = document.createElement('iframe');
-                iframe.src = '/clock';
-                previewPanel.appendChild(iframe);
-            } else {
-                // Start preview updates for regular patterns
-                startPreviewUpdates();
-            }
-
-            fetch('/pattern?value=' + value)
-                .then(response => response.text())
-                .then(data => {
-                    console.log('Pattern updated:', data);
-                    if (!selectedName.toLowerCase().includes('draw') && 
-                        !selectedName.toLowerCase().includes('video') &&
-                        !selectedName.toLowerCase().includes('text') &&
-                        !selectedName.toLowerCase().includes('type') &&
-                        !selectedName.toLowerCase().includes('snake') &&
-                        !selectedName.toLowerCase().includes('tetris') &&
-                        !selectedName.toLowerCase().includes('clock')) {
-                        // Wait 1 second before refreshing preview to allow pattern to initialize
-                        setTimeout(() => {
-                            refreshPreview();
-                        }, 1000);
-                    }
-                })
-                .catch(error => console.error('Error:', error));
-          }
-
-          function openModal() {
-            document.getElementById('settingsModal').classList.add('show');
-          }
-
-          function closeModal() {
-            document.getElementById('settingsModal').classList.remove('show');
-          }
-
-          // Close modal when clicking outside
-          document.addEventListener('click', function(event) {
-            const modal = document.getElementById('settingsModal');
-            const modalContent = modal.querySelector('.modal-content');
-            const settingsButton = document.querySelector('.settings-button');
-            
-            if (event.target === modal && !modalContent.contains(event.target) && !settingsButton.contains(event.target)) {
-              closeModal();
-            }
-          });
-
-          // Initialize preview on page load
-          document.addEventListener('DOMContentLoaded', function() {
-            // Initialize resizable controls panel
-            const controlsPanel = document.querySelector('.controls-panel');
-            const resizeHandle = document.querySelector('.resize-handle');
-            let isResizing = false;
-            let startX;
-            let startWidth;
-
-            resizeHandle.addEventListener('mousedown', function(e) {
-              isResizing = true;
-              startX = e.pageX;
-              startWidth = parseInt(document.defaultView.getComputedStyle(controlsPanel).width, 10);
-              resizeHandle.classList.add('active');
-              e.preventDefault(); // Prevent default selection behavior
-            });
-
-            document.addEventListener('mousemove', function(e) {
-              if (!isResizing) return;
-              
-              const width = startWidth + (e.pageX - startX);
-              // Ensure minimum width of 150px
-              if (width >= 150) {
-                controlsPanel.style.width = width + 'px';
-              }
-              e.preventDefault(); // Prevent default selection behavior
-            });
-
-            document.addEventListener('mouseup', function(e) {
-              isResizing = false;
-              resizeHandle.classList.remove('active');
-              document.body.style.cursor = 'default';
-            });
-
-            // Initialize pattern selection with current pattern number
-            updatePattern()rawliteral";
-
-    html += String(g_current_pattern_number);
-
-    html += R"rawliteral();
-          });
-        </script>
-      </body>
-      </html>
-    )rawliteral";
-
-    // Send response
-    request->send(200, "text/html; charset=utf-8", html);
+// -------------------------------------------------------------------
+// Handler for /state - the current pattern and settings, and the pattern
+// list, for the home page
+// -------------------------------------------------------------------
+static void setupStateHandler() {
+  server.on("/state", HTTP_GET, [](AsyncWebServerRequest *request) {
+    String json = "{\"pattern\":" + String(g_current_pattern_number) +
+                  ",\"brightness\":" + String(g_Brightness) +
+                  ",\"speed\":" + String(g_Speed) +
+                  ",\"previewInterval\":" + String(g_PreviewInterval) +
+                  ",\"patterns\":[";
+    for (size_t i = 0; i < PATTERN_COUNT; i++) {
+      json += String(i ? ",{" : "{") + "\"name\":" + jsonString(g_patternList[i].name) +
+              ",\"icon\":" + jsonString(g_patternList[i].icon) + "}";
+    }
+    json += "]}";
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", json);
+    response->addHeader("Cache-Control", "no-store");
+    request->send(response);
   });
 }
 
@@ -708,8 +334,11 @@ static void setupPatternHandler() {
       int pattern = patternStr.toInt();
       
       if (pattern >= 0 && pattern < PATTERN_COUNT) {
-        g_current_pattern_number = pattern;
-        request->send(200, "text/plain", "Pattern updated");
+        if (commandPost(CMD_SET_PATTERN, pattern)) {
+          request->send(200, "text/plain", "Pattern updated");
+        } else {
+          request->send(503, "text/plain", "Busy");
+        }
       } else {
         request->send(400, "text/plain", "Invalid pattern number");
       }
@@ -729,9 +358,13 @@ static void setupBrightnessHandler() {
       int brightness = brightnessStr.toInt();
       
       if (brightness >= 0 && brightness <= 255) {
-        g_Brightness = brightness;
-        saveBrightness(brightness);  // Save to NVS
-        request->send(200, "text/plain", "Brightness updated");
+        // Only saved once the renderer has it, so a busy reply changes nothing
+        if (commandPost(CMD_SET_BRIGHTNESS, brightness)) {
+          saveBrightness(brightness);  // Save to NVS
+          request->send(200, "text/plain", "Brightness updated");
+        } else {
+          request->send(503, "text/plain", "Busy");
+        }
       } else {
         request->send(400, "text/plain", "Invalid brightness value");
       }
@@ -751,9 +384,13 @@ static void setupSpeedHandler() {
       int speed = speedStr.toInt();
       
       if (speed >= 0 && speed <= 255) {
-        g_Speed = speed;
-        saveSpeed(speed);  // Save to NVS
-        request->send(200, "text/plain", "Speed updated");
+        // Only saved once the renderer has it, so a busy reply changes nothing
+        if (commandPost(CMD_SET_SPEED, speed)) {
+          saveSpeed(speed);  // Save to NVS
+          request->send(200, "text/plain", "Speed updated");
+        } else {
+          request->send(503, "text/plain", "Busy");
+        }
       } else {
         request->send(400, "text/plain", "Invalid speed value");
       }
@@ -764,35 +401,241 @@ static void setupSpeedHandler() {
 }
 
 // -------------------------------------------------------------------
-// Handler for /pixelStatus - returns current LED states
+// Send a lib/preview buffer as the response. The buffer is shared and
+// never changes, so the response reads straight from it as the socket
+// drains; the reference is handed back when the request goes away.
+// -------------------------------------------------------------------
+static void sendPreviewBuffer(AsyncWebServerRequest *request, const PreviewBuffer* buffer,
+                              const char* contentType) {
+  if (!buffer) {
+    request->send(503, "text/plain", "Out of memory");
+    return;
+  }
+  AsyncWebServerResponse *response = request->beginResponse(contentType, buffer->len,
+    [buffer](uint8_t* out, size_t maxLen, size_t index) -> size_t {
+      size_t n = min(maxLen, (size_t)buffer->len - index);
+      memcpy(out, buffer->data + index, n);
+      return n;
+    });
+  response->addHeader("Cache-Control", "no-store");
+  request->onDisconnect([buffer]() { previewRelease(buffer); });
+  request->send(response);
+}
+
+// -------------------------------------------------------------------
+// Handler for /pixelStatus - returns current LED states as 16x16 RGB.
+// With ?since=N it answers in the lib/preview format instead: unchanged,
+// the pixels that changed since preview N, or a keyframe. Pages use the
+// /previewws stream below and only poll this when it's unavailable.
 // -------------------------------------------------------------------
 static void setupPixelStatusHandler() {
   server.on("/pixelStatus", HTTP_GET, [](AsyncWebServerRequest *request) {
-    extern CRGB leds[];
-    
-    // Pre-allocate fixed size buffer (256 pixels * 3 bytes per pixel)
-    static uint8_t response[768];  // RGB values only, no terminator needed
-    uint8_t* ptr = response;
-    
-    // Process 16x16 grid with serpentine pattern
-    for (int y = 0; y < 16; y++) {
-      const bool isEvenRow = (y & 1) == 0;
-      const int rowStart = y << 4;  // y * 16
-      
-      for (int x = 0; x < 16; x++) {
-        // Calculate LED index - even rows reversed
-        const int ledIndex = rowStart + (isEvenRow ? 15 - x : x);
-        
-        // Direct binary copy - no conversion needed
-        *ptr++ = leds[ledIndex].r;
-        *ptr++ = leds[ledIndex].g;
-        *ptr++ = leds[ledIndex].b;
+    const PreviewBuffer* buffer;
+    if (request->hasParam("since")) {
+      buffer = previewMessage(strtoul(request->getParam("since")->value().c_str(), nullptr, 10));
+    } else {
+      buffer = previewAcquire(PREVIEW_RAW);  // RGB values only, no terminator needed
+    }
+    sendPreviewBuffer(request, buffer, "application/octet-stream");
+  });
+}
+
+// -------------------------------------------------------------------
+// Live preview pushed over the /previewws WebSocket, in the lib/preview
+// format. A client starts with a text message "interval=MS&since=N": how
+// often it wants frames and the preview it holds (0: none). Until then
+// it gets nothing. It may send "interval=MS" again at any time.
+//
+// wifiLoop() takes in each new frame and, when the preview has changed
+// and a client is due, fetches one message per distinct preview the due
+// clients hold (usually one) and sends it to all of them. The messages
+// come from lib/preview's cache, which /pixelStatus polls share.
+// A client whose send queue is still full is skipped for that frame
+// rather than queued further, and later gets a delta covering both.
+// -------------------------------------------------------------------
+#define PREVIEW_MAX_CLIENTS 4
+#define PREVIEW_MIN_INTERVAL 10
+#define PREVIEW_MAX_INTERVAL 10000
+
+struct PreviewClient {
+  uint32_t id;            // 0: free slot
+  bool ready;             // has said which preview it holds
+  uint16_t intervalMs;
+  uint32_t lastSentMs;
+  uint32_t sequence;      // preview the client holds
+};
+
+static AsyncWebSocket s_previewSocket("/previewws");
+static PreviewClient s_previewClients[PREVIEW_MAX_CLIENTS];
+// Slots are claimed on the web server's task and read by wifiLoop()
+static portMUX_TYPE s_previewLock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_previewMessages = 0, s_previewSent = 0, s_previewBusy = 0;
+
+static PreviewClient* findPreviewClient(uint32_t id) {
+  for (PreviewClient& c : s_previewClients) {
+    if (c.id == id) return &c;
+  }
+  return nullptr;
+}
+
+// Value of `key` in "a=1&b=2", or -1
+static long messageValue(const char* text, const char* key) {
+  size_t keyLen = strlen(key);
+  for (const char* p = text; p; p = strchr(p, '&')) {
+    if (*p == '&') p++;
+    if (!strncmp(p, key, keyLen) && p[keyLen] == '=') {
+      return strtol(p + keyLen + 1, nullptr, 10);
+    }
+  }
+  return -1;
+}
+
+static void onPreviewSocketEvent(AsyncWebSocket* socket, AsyncWebSocketClient* client, AwsEventType type,
+                                 void* arg, uint8_t* data, size_t len) {
+  if (type == WS_EVT_CONNECT) {
+    portENTER_CRITICAL(&s_previewLock);
+    PreviewClient* slot = findPreviewClient(0);
+    if (slot) {
+      *slot = PreviewClient{client->id(), false, (uint16_t)g_PreviewInterval, 0, 0};
+    }
+    portEXIT_CRITICAL(&s_previewLock);
+    if (!slot) {
+      client->close();   // the page falls back to polling
+    }
+  } else if (type == WS_EVT_DISCONNECT) {
+    portENTER_CRITICAL(&s_previewLock);
+    PreviewClient* slot = findPreviewClient(client->id());
+    if (slot) slot->id = 0;
+    portEXIT_CRITICAL(&s_previewLock);
+  } else if (type == WS_EVT_DATA) {
+    AwsFrameInfo* info = (AwsFrameInfo*)arg;
+    if (info->opcode != WS_TEXT || info->index != 0 || len > 40) {
+      return;
+    }
+    char text[41];
+    memcpy(text, data, len);
+    text[len] = 0;
+    long interval = messageValue(text, "interval");
+    long since = messageValue(text, "since");
+
+    portENTER_CRITICAL(&s_previewLock);
+    PreviewClient* slot = findPreviewClient(client->id());
+    if (slot && interval >= 0) {
+      slot->intervalMs = constrain(interval, PREVIEW_MIN_INTERVAL, PREVIEW_MAX_INTERVAL);
+    }
+    if (slot && since >= 0) {
+      slot->sequence = since;
+      slot->ready = true;
+    }
+    portEXIT_CRITICAL(&s_previewLock);
+  }
+}
+
+static void pushPreview() {
+  static uint32_t lastCleanup = 0;
+  uint32_t now = millis();
+  if (now - lastCleanup >= 1000) {
+    s_previewSocket.cleanupClients(PREVIEW_MAX_CLIENTS);
+    lastCleanup = now;
+  }
+
+  // The /pixelStatus handler reads this too, so keep it current even
+  // with no socket clients
+  uint32_t sequence = previewUpdate();
+
+  // Who is behind and due?
+  PreviewClient due[PREVIEW_MAX_CLIENTS];
+  uint8_t dueCount = 0;
+  portENTER_CRITICAL(&s_previewLock);
+  for (const PreviewClient& c : s_previewClients) {
+    if (c.id && c.ready && c.sequence != sequence && now - c.lastSentMs >= c.intervalMs) {
+      due[dueCount++] = c;
+    }
+  }
+  portEXIT_CRITICAL(&s_previewLock);
+
+  for (uint8_t i = 0; i < dueCount; i++) {
+    if (!due[i].id) {
+      continue;   // already served with an earlier client's message
+    }
+    // Cached in lib/preview, and held until every client holding the same
+    // preview has queued it. Each client's queue takes its own copy: the
+    // library's shared message buffers are only freed by internals it
+    // doesn't expose.
+    const PreviewBuffer* message = previewMessage(due[i].sequence);
+    s_previewMessages++;
+    if (!message) {
+      break;
+    }
+    for (uint8_t j = i; j < dueCount; j++) {
+      if (!due[j].id || due[j].sequence != due[i].sequence) {
+        continue;
       }
+      AsyncWebSocketClient* client = s_previewSocket.client(due[j].id);
+      if (client && client->status() == WS_CONNECTED) {
+        if (client->queueIsFull()) {
+          s_previewBusy++;
+        } else {
+          client->binary(message->data, message->len);
+          s_previewSent++;
+
+          portENTER_CRITICAL(&s_previewLock);
+          PreviewClient* slot = findPreviewClient(due[j].id);
+          if (slot) {
+            slot->lastSentMs = now;
+            slot->sequence = sequence;
+          }
+          portEXIT_CRITICAL(&s_previewLock);
+        }
+      }
+      if (j != i) due[j].id = 0;
+    }
+    previewRelease(message);
+  }
+}
+
+// -------------------------------------------------------------------
+// /preview.js (web/preview.js) - the client side of the preview, shared
+// by every page with a preview grid. PixelPreview.start(ms) paints the elements
+// pixel-0 .. pixel-255 from the /previewws stream, polling
+// /pixelStatus?since= every `ms` instead while the socket is down. Only
+// the pixels a message changes are repainted.
+// -------------------------------------------------------------------
+static void setupPreviewHandlers() {
+  s_previewSocket.onEvent(onPreviewSocketEvent);
+  server.addHandler(&s_previewSocket);
+
+  webServeAsset(&server, "/preview.js", WEB_PREVIEW_JS);
+
+  // Preview counters, for checking the fan-out, the encoding and the
+  // cache. The message counts and bytes cover /pixelStatus?since= polls
+  // as well.
+  server.on("/previewStats", HTTP_GET, [](AsyncWebServerRequest *request) {
+    PreviewStats stats;
+    previewGetStats(&stats);
+    String json = "{\"clients\":" + String((unsigned)s_previewSocket.count()) +
+                  ",\"messages\":" + String(s_previewMessages) +
+                  ",\"sent\":" + String(s_previewSent) +
+                  ",\"skippedBusy\":" + String(s_previewBusy) +
+                  ",\"sequence\":" + String(stats.sequence) +
+                  ",\"unchanged\":" + String(stats.unchanged) +
+                  ",\"keyframes\":" + String(stats.keyframes) +
+                  ",\"deltas\":" + String(stats.deltas) +
+                  ",\"bytes\":" + String(stats.bytes) +
+                  ",\"uncachedDeltas\":" + String(stats.uncached) +
+                  ",\"liveBuffers\":" + String(stats.liveBuffers) +
+                  ",\"cache\":{";
+
+    // Hits and misses per encoding, and the share of requests that hit
+    static const char* const names[PREVIEW_ENCODINGS] = {"raw", "ico", "unchanged", "next", "keyframe"};
+    for (uint8_t e = 0; e < PREVIEW_ENCODINGS; e++) {
+      uint32_t total = stats.hits[e] + stats.misses[e];
+      json += String(e ? ",\"" : "\"") + names[e] + "\":{\"hits\":" + String(stats.hits[e]) +
+              ",\"misses\":" + String(stats.misses[e]) +
+              ",\"hitRatio\":" + String(total ? (float)stats.hits[e] / total : 0.0f, 3) + "}";
     }
-    
-    AsyncWebServerResponse *response_obj = request->beginResponse(200, "application/octet-stream", response, 768);
-    response_obj->addHeader("Cache-Control", "no-store");
-    request->send(response_obj);
+    json += "}}";
+    request->send(200, "application/json", json);
   });
 }
 
@@ -818,6 +661,127 @@ static void setupPreviewIntervalHandler() {
   });
 }
 
+// -------------------------------------------------------------------
+// Handler for /geometry - reports the display layout, or changes it.
+// Any of panelWidth, panelHeight, tilesX, tilesY (1..255), wiring (0
+// serpentine, 1 progressive), rotation (quarter turns, 0..3), mirror and
+// serpentineTiles (0/1) may be given; the new layout is saved and the
+// board restarts. A value out of range gets a 400 naming it.
+// -------------------------------------------------------------------
+// Digits, with an optional leading minus; toInt() reads anything else as 0
+static bool isWholeNumber(const String& text) {
+  if (text.length() == 0) {
+    return false;
+  }
+  for (size_t i = text[0] == '-' ? 1 : 0; i < text.length(); i++) {
+    if (!isdigit((unsigned char)text[i])) {
+      return false;
+    }
+  }
+  return text != "-";
+}
+
+static void setupGeometryHandler() {
+  server.on("/geometry", HTTP_GET, [](AsyncWebServerRequest *request) {
+    LedGeometry g = g_geometry;
+    bool changed = false;
+    const char* bad = nullptr;
+    // Each value has to be a whole number within its field's range; the
+    // first one that isn't is reported
+    auto param = [&](const char* name, uint8_t& field, int lo, int hi) {
+      if (bad || !request->hasParam(name)) {
+        return;
+      }
+      const String& text = request->getParam(name)->value();
+      int value = text.toInt();
+      if (!isWholeNumber(text) || value < lo || value > hi) {
+        bad = name;
+        return;
+      }
+      field = value;
+      changed = true;
+    };
+    uint8_t mirror = g.mirror, serpentineTiles = g.serpentineTiles;
+    param("panelWidth", g.panelWidth, 1, 255);
+    param("panelHeight", g.panelHeight, 1, 255);
+    param("tilesX", g.tilesX, 1, 255);
+    param("tilesY", g.tilesY, 1, 255);
+    param("wiring", g.wiring, LED_WIRING_SERPENTINE, LED_WIRING_PROGRESSIVE);
+    param("rotation", g.rotation, 0, 3);
+    param("mirror", mirror, 0, 1);
+    param("serpentineTiles", serpentineTiles, 0, 1);
+    g.mirror = mirror;
+    g.serpentineTiles = serpentineTiles;
+    if (bad) {
+      request->send(400, "text/plain", String("Invalid ") + bad);
+      return;
+    }
+
+    if (changed) {
+      if (!led_save_geometry(g)) {
+        request->send(400, "text/plain", "Invalid geometry (at most " + String(LED_MAX_LEDS) + " LEDs)");
+        return;
+      }
+      // Buffers and pattern state are sized at boot, so restart once the
+      // response has gone out
+      request->onDisconnect([]() { ESP.restart(); });
+    }
+
+    LedOutputStats stats;
+    led_output_stats(&stats);
+    String json = "{\"width\":" + String(g.width()) +
+                  ",\"height\":" + String(g.height()) +
+                  ",\"panelWidth\":" + String(g.panelWidth) +
+                  ",\"panelHeight\":" + String(g.panelHeight) +
+                  ",\"tilesX\":" + String(g.tilesX) +
+                  ",\"tilesY\":" + String(g.tilesY) +
+                  ",\"wiring\":" + String(g.wiring) +
+                  ",\"rotation\":" + String(g.rotation) +
+                  ",\"mirror\":" + String(g.mirror ? 1 : 0) +
+                  ",\"serpentineTiles\":" + String(g.serpentineTiles ? 1 : 0) +
+                  ",\"outputs\":" + String(stats.outputs) +
+                  ",\"showUs\":" + String(stats.averageShowUs) +
+                  ",\"restarting\":" + (changed ? "true" : "false") + "}";
+    request->send(200, "application/json", json);
+  });
+}
+
+// -------------------------------------------------------------------
+// Handler for /metrics - render loop timing as JSON: a summary plus the
+// last METRICS_FRAMES frames, one array per frame in "fields" order
+// -------------------------------------------------------------------
+static void setupMetricsHandler() {
+  server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request) {
+    MetricsSummary m;
+    metricsSummarize(&m);
+    String json;
+    json.reserve(256 + METRICS_FRAMES * 48);
+    json = "{\"fps\":" + String(m.fps, 1) +
+           ",\"renderUs\":{\"mean\":" + String(m.renderMeanUs) + ",\"max\":" + String(m.renderMaxUs) + "}" +
+           ",\"showUs\":{\"mean\":" + String(m.showMeanUs) + ",\"max\":" + String(m.showMaxUs) + "}" +
+           ",\"lateUs\":{\"mean\":" + String(m.lateMeanUs) + ",\"max\":" + String(m.lateMaxUs) + "}" +
+           ",\"idleUs\":{\"mean\":" + String(m.idleMeanUs) + "}" +
+           ",\"lateFrames\":" + String(m.lateFrames) +
+           ",\"presented\":" + String(m.presented) +
+           ",\"dropped\":" + String(m.dropped) +
+           ",\"fields\":[\"startUs\",\"periodUs\",\"lateUs\",\"idleUs\",\"renderUs\",\"showUs\"]" +
+           ",\"frames\":[";
+
+    // Copied out in one go, the ring keeps moving while we format
+    FrameMetrics* frames = (FrameMetrics*)malloc(METRICS_FRAMES * sizeof(FrameMetrics));
+    size_t n = frames ? metricsSnapshot(frames, METRICS_FRAMES) : 0;
+    for (size_t i = 0; i < n; i++) {
+      const FrameMetrics& f = frames[i];
+      json += (i ? ",[" : "[") + String(f.startUs) + "," + String(f.periodUs) + "," +
+              String(f.lateUs) + "," + String(f.idleUs) + "," + String(f.renderUs) + "," +
+              String(f.showUs) + "]";
+    }
+    free(frames);
+    json += "]}";
+    request->send(200, "application/json", json);
+  });
+}
+
 // -------------------------------------------------------------------
 // Handler for /style.css - returns shared CSS styles
 // -------------------------------------------------------------------
@@ -831,84 +795,7 @@ static void setupStyleHandler() {
 // -------------------------------------------------------------------
 static void setupFaviconHandler() {
   server.on("/favicon.ico", HTTP_GET, [](AsyncWebServerRequest *request) {
-    extern CRGB leds[];
-    
-    // ICO file format requires:
-    // - 6 bytes for ICO header
-    // - 16 bytes for ICO directory entry
-    // - Bitmap header (40 bytes)
-    // - Color data (16x16x4 bytes)
-    static uint8_t icoFile[6 + 16 + 40 + (16 * 16 * 4)];
-    uint8_t* ptr = icoFile;
-    
-    // ICO Header (6 bytes)
-    *ptr++ = 0x00;  // Reserved, must be 0
-    *ptr++ = 0x00;  // Reserved, must be 0
-    *ptr++ = 0x01;  // Type (1 for ICO)
-    *ptr++ = 0x00;  // Type
-    *ptr++ = 0x01;  // Number of images
-    *ptr++ = 0x00;  // Number of images
-    
-    // ICO Directory Entry (16 bytes)
-    *ptr++ = 16;    // Width
-    *ptr++ = 16;    // Height
-    *ptr++ = 0;     // Color palette size (0 for no palette)
-    *ptr++ = 0;     // Reserved, must be 0
-    *ptr++ = 1;     // Color planes
-    *ptr++ = 0;     // Color planes
-    *ptr++ = 32;    // Bits per pixel
-    *ptr++ = 0;     // Bits per pixel
-    uint32_t size = 40 + (16 * 16 * 4);  // Size of bitmap data + header
-    *ptr++ = size & 0xFF;          // Image size in bytes
-    *ptr++ = (size >> 8) & 0xFF;
-    *ptr++ = (size >> 16) & 0xFF;
-    *ptr++ = (size >> 24) & 0xFF;
-    *ptr++ = 22;    // Offset to start of image data (6 + 16)
-    *ptr++ = 0;     // Offset
-    *ptr++ = 0;     // Offset
-    *ptr++ = 0;     // Offset
-    
-    // Bitmap Header (40 bytes)
-    *ptr++ = 40;    // Header size
-    *ptr++ = 0;     // Header size
-    *ptr++ = 0;     // Header size
-    *ptr++ = 0;     // Header size
-    *ptr++ = 16;    // Width
-    *ptr++ = 0;     // Width
-    *ptr++ = 0;     // Width
-    *ptr++ = 0;     // Width
-    *ptr++ = 32;    // Height (16 * 2 because ICO format requires doubled height)
-    *ptr++ = 0;     // Height
-    *ptr++ = 0;     // Height
-    *ptr++ = 0;     // Height
-    *ptr++ = 1;     // Planes
-    *ptr++ = 0;     // Planes
-    *ptr++ = 32;    // Bits per pixel
-    *ptr++ = 0;     // Bits per pixel
-    for (int i = 0; i < 24; i++) {  // Rest of bitmap header (compression, etc.)
-      *ptr++ = 0;
-    }
-    
-    // Image data (bottom-up, BGRA format)
-    for (int y = 15; y >= 0; y--) {  // ICO format requires bottom-up pixel data
-      const bool isEvenRow = (y & 1) == 0;
-      const int rowStart = y << 4;  // y * 16
-      
-      for (int x = 0; x < 16; x++) {
-        // Calculate LED index - even rows reversed
-        const int ledIndex = rowStart + (isEvenRow ? 15 - x : x);
-        
-        // Write in BGRA format (ICO/BMP expects BGR)
-        *ptr++ = leds[ledIndex].b;  // Blue
-        *ptr++ = leds[ledIndex].g;  // Green
-        *ptr++ = leds[ledIndex].r;  // Red
-        *ptr++ = 255;               // Alpha
-      }
-    }
-    
-    AsyncWebServerResponse *response = request->beginResponse(200, "image/x-icon", icoFile, sizeof(icoFile));
-    response->addHeader("Cache-Control", "no-cache");
-    request->send(response);
+    sendPreviewBuffer(request, previewAcquire(PREVIEW_ICO), "image/x-icon");
   });
 }
 
@@ -918,13 +805,17 @@ static void setupFaviconHandler() {
 static void startServer() {
   // Setup all the web handlers
   setupHomePage();
+  setupStateHandler();
   setupPatternHandler();
   setupBrightnessHandler();
   setupSpeedHandler();
   setupPixelStatusHandler();
+  setupPreviewHandlers();
   setupPreviewIntervalHandler();
   setupStyleHandler();
   setupFaviconHandler();
+  setupGeometryHandler();
+  setupMetricsHandler();
 
   // Setup pattern-specific handlers
   setupDrawPattern(&server);
@@ -933,6 +824,7 @@ static void startServer() {
   setupSnakePattern(&server);
   setupTetrisPattern(&server);
   setupClockPattern(&server);
+  setupAnimationPattern(&server);
 #if ENABLE_MICROPHONE
   setupAudioPattern(&server);
 #endif
@@ -956,19 +848,8 @@ void wifiServerSetup() {
   // If we have a successful STA connection, serve normal pages:
   if (WiFi.status() == WL_CONNECTED) {
     setupMDNS();
-    setupHomePage();
-    setupPatternHandler();
-    setupBrightnessHandler();
-    setupSpeedHandler();
-    setupVideoPlayer(&server);
-    setupDrawPattern(&server);
-    setupTypePattern(&server);
-    setupSnakePattern(&server);
-    setupTetrisPattern(&server);
-    setupClockPattern(&server);
-#if ENABLE_MICROPHONE
-    setupAudioPattern(&server);
-#endif
+    // Registers every handler once; the video and preview sockets must
+    // not be added to the server twice
     startServer();
 
     // Debug: List files in SPIFFS
@@ -995,9 +876,10 @@ void wifiServerSetup() {
 }
 
 // -------------------------------------------------------------------
-// wifiLoop - rarely needed if using AsyncWebServer. 
-// Typically empty, but you can place background tasks here if needed.
+// wifiLoop - called from loop(). The server itself runs on the AsyncTCP
+// task; this only pushes preview frames and tidies up the sockets.
 // -------------------------------------------------------------------
 void wifiLoop() {
-  // No-op for now
+  pushPreview();
+  videoLoop();
 }
\ No newline at end of file
@@ -5,25 +5,52 @@
 #include "WifiServer.h"
 #include <Preferences.h>
 #include <patterns.h>  
+#include <commands.h>
+#include "snake/snake.h"
+#include "tetris/tetris.h"
+#include "clock/clock.h"
+#include "type/type.h"
+#include "animation/animation.h"
+#include <bench.h>
+#include <metrics.h>
 #include "SPIFFS.h"
 #include <esp_sleep.h>
 #include <WiFi.h>
+#include <atomic>
 
 // Feature flags
 
 
-#define DATA_PIN 26
-#define NUM_LEDS 256
-#define COLOR_ORDER GRB
 #define BUTTON_PIN 0  // Built-in boot button on most ESP32 dev boards
 
+// The renderer gets core 1 to itself (plus the LED output task); WiFi and
+// the AsyncTCP web stack run on core 0 (see platformio.ini)
+#define RENDER_CORE     1
+#define RENDER_PRIORITY 3
+
 Preferences preferences;
 
 uint8_t g_hue = 0; 
-CRGB leds[NUM_LEDS];
+CRGB leds[LED_MAX_LEDS];        // back buffer, only touched by the renderer
 int g_Brightness = 96;
 int g_Speed = 120;
 uint8_t g_current_pattern_number = 0;
+uint32_t g_frameDeltaMs = 0;    // ms between the start of the last two frames
+
+// Frame scheduler state: when the current frame started and how long the
+// pattern asked us to wait before the next one (see setFrameDelay()).
+static uint32_t s_lastFrameStart = 0;
+static uint16_t s_framePeriod = 0;
+static uint32_t s_lastFrameStartUs = 0;
+static uint32_t s_lastFrameEndUs = 0;      // 0 until the first frame
+static int s_lastPatternNumber = -1;
+TaskHandle_t g_renderTask = nullptr;
+static void startRenderTask();
+
+// Frames per pattern for a benchmark asked for over serial, 0 for none.
+// Set by loop() and taken by the render task; the command queue has a
+// single producer, the AsyncTCP task, so loop() can't post to it.
+static std::atomic<uint16_t> s_benchFrames(0);
 
 // The single place where patterns + names are stored (patterns_index.h/.cpp):
 extern Pattern g_patternList[];          // [ "Fire", firefunction ], ...
@@ -92,25 +119,20 @@ void setup() {
   // Load preferences regardless of wake-up reason
   loadPrefs();
   
-  // Configure the LED strip
-  FastLED.addLeds<LED_TYPE, DATA_PIN, COLOR_ORDER>(leds, NUM_LEDS)
-         .setCorrection(TypicalLEDStrip);
-
-  // Start with display off
-  FastLED.setBrightness(0);
-  FastLED.show();
+  // Configure the LED strip and start the output task (display starts off)
+  led_setup();
 
   // Setup WiFi and server if this is a normal boot or we need to reconnect
   if (wakeup_reason != ESP_SLEEP_WAKEUP_WIFI) {
     wifiServerSetup();  // connect to WiFi, start server, etc.
-    nap(2000); // Wait for WiFi to stabilize
+    delay(2000); // Wait for WiFi to stabilize
   }
 
-  // Set normal brightness
-  FastLED.setBrightness(g_Brightness);
-
-  // Initialize SPIFFS
-  if(!SPIFFS.begin()){
+  // Initialize SPIFFS before rendering starts, some patterns stream their
+  // frames from it
+  bool spiffsMounted = SPIFFS.begin();
+  startRenderTask();
+  if(!spiffsMounted){
     Serial.println("SPIFFS Mount Failed");
     return;
   }
@@ -125,16 +147,148 @@ void setup() {
   }
 }
 
-void loop()
-{
-  // Call the function pointer from the struct
-  g_patternList[g_current_pattern_number].func(leds);
+static void printLine(const char* line) {
+  Serial.println(line);
+}
+
+// Benchmark every pattern. This runs in the render task, which owns the
+// pattern state; the current pattern is switched out first and the next
+// renderFrame() switches it back in.
+static void runBenchmark(uint16_t frames) {
+  if (s_lastPatternNumber >= 0) {
+    endPattern(s_lastPatternNumber);
+    s_lastPatternNumber = -1;
+  }
+  benchRun(leds, frames, BENCH_DEFAULT_SEED, printLine);
+  benchPreview(leds, frames, BENCH_DEFAULT_SEED, printLine);
+  benchMath(frames, printLine);
+  benchTetris(frames, BENCH_DEFAULT_SEED, printLine);
+  s_lastFrameEndUs = 0;
+}
+
+// Apply one control message from the web handlers. Settings are simply
+// overwritten, so a burst of slider updates within one frame costs a few
+// stores and only the last value is ever rendered.
+static void applyCommand(Command& cmd) {
+  switch (cmd.type) {
+    case CMD_SET_PATTERN:
+      if (cmd.value >= 0 && cmd.value < (int32_t)PATTERN_COUNT) {
+        g_current_pattern_number = cmd.value;
+      }
+      break;
+    case CMD_SET_BRIGHTNESS:  g_Brightness = cmd.value; break;
+    case CMD_SET_SPEED:       g_Speed = cmd.value; break;
+    case CMD_SNAKE_DIRECTION: snakeApplyDirection(cmd.arg); break;
+    case CMD_SNAKE_ACTION:    snakeApplyAction(cmd.arg); break;
+    case CMD_TETRIS_ACTION:   tetrisApplyAction(cmd.arg); break;
+    case CMD_CLOCK_ACTION:    clockApplyAction(cmd.arg, cmd.value); break;
+    case CMD_SET_TEXT:
+      typeSetText(cmd.text, CRGB((uint32_t)cmd.value), CRGB((uint32_t)cmd.value2), cmd.arg);
+      break;
+    case CMD_SET_ANIMATION:   animationSelect(cmd.text); break;
+    case CMD_INSTALL_ANIMATION:
+      // The current pattern may be streaming the sheet being replaced
+      // (Animation, Jelly Fish, or either one under Random), so switch it
+      // out; the next renderFrame() switches it back in
+      if (s_lastPatternNumber >= 0) {
+        endPattern(s_lastPatternNumber);
+        s_lastPatternNumber = -1;
+      }
+      animationInstall(cmd.text);
+      break;
+  }
+  free(cmd.text);
+}
+
+// Render one frame if it is due: switch patterns if requested, run the
+// current pattern once, then present the result. Patterns never sleep or
+// call FastLED.show() themselves, so brightness changes and pattern
+// switches land on the next frame instead of waiting for a pattern's
+// delay to finish.
+static void renderFrame() {
+  Command cmd;
+  while (commandTake(&cmd)) {
+    applyCommand(cmd);
+  }
+  uint16_t benchFrames = s_benchFrames.exchange(0);
+  if (benchFrames) {
+    runBenchmark(benchFrames);
+  }
 
-  FastLED.show();
-  FastLED.setBrightness(g_Brightness);
+  uint32_t now = millis();
+  bool patternChanged = (g_current_pattern_number != s_lastPatternNumber);
 
-  EVERY_N_MILLISECONDS(10) { g_hue++; } // Slowly cycle the base color
+  if (!patternChanged && !g_frameRequested && now - s_lastFrameStart < s_framePeriod) {
+    return;
+  }
+  bool scheduled = !patternChanged && !g_frameRequested;
+  g_frameRequested = false;
+
+  // Frames forced by a switch or requestFrame() are never late
+  uint32_t startUs = micros();
+  int32_t lateUs = (int32_t)(startUs - s_lastFrameStartUs - s_framePeriod * 1000u);
+  FrameMetrics metrics;
+  metrics.startUs = startUs;
+  metrics.periodUs = s_framePeriod * 1000u;
+  metrics.lateUs = scheduled && lateUs > 0 ? lateUs : 0;
+  // Nothing to be idle after on the first frame, nor after a benchmark
+  metrics.idleUs = s_lastFrameEndUs ? startUs - s_lastFrameEndUs : 0;
+  s_lastFrameStartUs = startUs;
+
+  // Hand over between patterns: the old one releases its state before the
+  // new one allocates, so only one pattern's working memory is live
+  if (patternChanged) {
+    int next = g_current_pattern_number;
+    if (s_lastPatternNumber >= 0) {
+      endPattern(s_lastPatternNumber);
+    }
+    beginPattern(next);
+    Serial.printf("Pattern: %s (%u bytes state, %u bytes heap free)\n",
+                  g_patternList[next].name, (unsigned)patternStateSize(next),
+                  (unsigned)ESP.getFreeHeap());
+    s_lastPatternNumber = next;
+  }
+
+  g_frameDeltaMs = now - s_lastFrameStart;
+  s_lastFrameStart = now;
+
+  // Patterns that don't ask for a specific delay get the default period
+  setFrameDelay(1);
+  g_patternList[s_lastPatternNumber].func(leds);
+  s_framePeriod = g_frameDelay;
+
+  // Hand the finished frame to the output task
+  led_present(leds, g_Brightness);
+
+  LedOutputStats stats;
+  led_output_stats(&stats);
+  s_lastFrameEndUs = micros();
+  metrics.renderUs = s_lastFrameEndUs - startUs;
+  metrics.showUs = stats.lastShowUs;
+  metricsRecord(metrics);
+}
+
+// Render loop, pinned to RENDER_CORE. Between frames the task sleeps until
+// the next one is due, or until requestFrame() wakes it early.
+static void renderTask(void* param) {
+  for (;;) {
+    g_hue = millis() / 10;  // Slowly cycle the base color
+    renderFrame();
+
+    uint32_t elapsed = millis() - s_lastFrameStart;
+    uint32_t wait = elapsed < s_framePeriod ? s_framePeriod - elapsed : 1;
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+  }
+}
 
+static void startRenderTask() {
+  xTaskCreatePinnedToCore(renderTask, "render", 8192, nullptr,
+                          RENDER_PRIORITY, &g_renderTask, RENDER_CORE);
+}
+
+// loop() only does housekeeping now; all drawing happens in renderTask()
+void loop()
+{
   // Periodic saves
   EVERY_N_SECONDS(15) { savePrefs(); }
 
@@ -145,8 +299,33 @@ void loop()
     
     if (cmd == "clearwifi") {
       clearWiFiCredentials();
+    } else if (cmd == "benchxy") {
+      led_benchmark_mapping();
+    } else if (cmd == "bench" || cmd.startsWith("bench ")) {
+      // "bench 500" renders 500 frames of each pattern
+      int frames = cmd.length() > 6 ? cmd.substring(6).toInt() : BENCH_DEFAULT_FRAMES;
+      s_benchFrames = constrain(frames, 1, BENCH_MAX_FRAMES);
+      xTaskNotifyGive(g_renderTask);
+    } else if (cmd == "metrics") {
+      MetricsSummary m;
+      metricsSummarize(&m);
+      Serial.printf("%.1f fps over %u frames: render %u us avg / %u max, show() %u / %u, "
+                    "late %u / %u (%u frames), idle %u avg, %u of %u presented frames dropped\n",
+                    m.fps, m.frames, (unsigned)m.renderMeanUs, (unsigned)m.renderMaxUs,
+                    (unsigned)m.showMeanUs, (unsigned)m.showMaxUs, (unsigned)m.lateMeanUs,
+                    (unsigned)m.lateMaxUs, m.lateFrames, (unsigned)m.idleMeanUs,
+                    (unsigned)m.dropped, (unsigned)m.presented);
+    } else if (cmd == "leds") {
+      LedOutputStats stats;
+      led_output_stats(&stats);
+      Serial.printf("%u LEDs on %u output(s), up to %u each: show() %u us last, %u us average over %u frames\n",
+                    NUM_LEDS, stats.outputs, stats.ledsPerOutput, (unsigned)stats.lastShowUs,
+                    (unsigned)stats.averageShowUs, (unsigned)stats.frames);
     }
   }
 
-  nap(1);
+  // Push live preview frames to connected pages
+  wifiLoop();
+
+  delay(10);
 }
\ No newline at end of file
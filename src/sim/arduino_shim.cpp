@@ -0,0 +1,133 @@
+// Host implementation of the Arduino core shim (shims/Arduino.h)
+#include <Arduino.h>
+#include <stdarg.h>
+#include <atomic>
+#include <chrono>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// ---------------------------------------------------------------- time
+static uint64_t s_virtualMicros = 0;
+
+unsigned long millis() { return (unsigned long)(s_virtualMicros / 1000); }
+unsigned long micros() { return (unsigned long)s_virtualMicros; }
+void simAdvanceMicros(uint64_t us) { s_virtualMicros += us; }
+void delay(unsigned long ms) { s_virtualMicros += (uint64_t)ms * 1000; }
+void delayMicroseconds(unsigned int us) { s_virtualMicros += us; }
+void yield() {}
+
+// ---------------------------------------------------------------- random
+static uint32_t s_randState = 1;
+
+void randomSeed(unsigned long seed) { s_randState = seed ? seed : 1; }
+
+static uint32_t nextRandom() {
+  // xorshift32: fast and identical on every host
+  s_randState ^= s_randState << 13;
+  s_randState ^= s_randState >> 17;
+  s_randState ^= s_randState << 5;
+  return s_randState;
+}
+
+long random(long howbig) { return howbig <= 0 ? 0 : (long)(nextRandom() % (uint32_t)howbig); }
+long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+
+// ---------------------------------------------------------------- GPIO
+void pinMode(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; }
+uint16_t analogRead(uint8_t) { return 2048; }
+
+// ---------------------------------------------------------------- Serial
+int HardwareSerial::printf(const char* fmt, ...) {
+  if (quiet_) return 0;
+  va_list args;
+  va_start(args, fmt);
+  int n = vfprintf(stderr, fmt, args);
+  va_end(args);
+  return n;
+}
+size_t HardwareSerial::print(const String& s) { return quiet_ ? 0 : fputs(s.c_str(), stderr); }
+size_t HardwareSerial::print(const char* s) { return quiet_ ? 0 : fputs(s, stderr); }
+size_t HardwareSerial::print(int v) { return printf("%d", v); }
+size_t HardwareSerial::print(unsigned long v) { return printf("%lu", v); }
+size_t HardwareSerial::println(const String& s) { return printf("%s\n", s.c_str()); }
+size_t HardwareSerial::println(const char* s) { return printf("%s\n", s); }
+size_t HardwareSerial::println(int v) { return printf("%d\n", v); }
+size_t HardwareSerial::println(unsigned long v) { return printf("%lu\n", v); }
+
+// ---------------------------------------------------------------- FreeRTOS
+void portENTER_CRITICAL(portMUX_TYPE* mux) {}
+void portEXIT_CRITICAL(portMUX_TYPE* mux) {}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack,
+                                   void* param, UBaseType_t prio, TaskHandle_t* handle, BaseType_t core) {
+  if (handle) *handle = nullptr;
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) { return 0; }
+BaseType_t xTaskNotifyGive(TaskHandle_t task) { return pdPASS; }
+void vTaskDelay(TickType_t ticks) { delay(ticks * portTICK_PERIOD_MS); }
+TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) { return 64 * 1024; }
+BaseType_t xPortGetCoreID() { return 1; }
+
+// ---------------------------------------------------------------- heap
+// glibc keeps small freed blocks in per-thread caches that still count as
+// in use, so heap usage is tracked here instead, by wrapping the allocator.
+// Elsewhere the heap just looks unused. Atomic for the Tetris harness's
+// worker threads.
+static std::atomic<int64_t> s_heapUsed(0);
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+  void* p = __libc_malloc(size);
+  if (p) s_heapUsed += malloc_usable_size(p);
+  return p;
+}
+
+void* calloc(size_t count, size_t size) {
+  void* p = __libc_calloc(count, size);
+  if (p) s_heapUsed += malloc_usable_size(p);
+  return p;
+}
+
+void* realloc(void* ptr, size_t size) {
+  size_t old = ptr ? malloc_usable_size(ptr) : 0;
+  void* p = __libc_realloc(ptr, size);
+  if (p || size == 0) s_heapUsed -= old;
+  if (p) s_heapUsed += malloc_usable_size(p);
+  return p;
+}
+
+void free(void* ptr) {
+  if (ptr) s_heapUsed -= malloc_usable_size(ptr);
+  __libc_free(ptr);
+}
+}
+#endif
+
+// ---------------------------------------------------------------- ESP
+// A pretend 4 MB heap, like a WROVER with PSRAM
+uint32_t EspClass::getHeapSize() { return 4 * 1024 * 1024; }
+uint32_t EspClass::getFreeHeap() { return getHeapSize() - (uint32_t)s_heapUsed.load(); }
+
+// Host time in nanoseconds stands in for the cycle counter, so the
+// benchmarks still compare like with like. The clock is read once at
+// startup, its first read is much slower and deeper than the rest.
+static const auto s_clockStart = std::chrono::steady_clock::now();
+
+uint32_t EspClass::getCycleCount() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - s_clockStart).count();
+}
@@ -0,0 +1,190 @@
+// Host implementation of the FastLED shim (shims/FastLED.h). The math
+// follows FastLED's portable C code so colors match the device.
+#include <FastLED.h>
+
+CFastLED FastLED;
+uint16_t rand16seed = 1337;
+
+// ---------------------------------------------------------------- FastLED math
+int16_t sin16(uint16_t theta) {
+  static const uint16_t base[] = { 0, 6393, 12539, 18204, 23170, 27245, 30273, 32137 };
+  static const uint8_t slope[] = { 49, 48, 44, 38, 31, 23, 14, 4 };
+  uint16_t offset = (theta & 0x3FFF) >> 3;
+  if (theta & 0x4000) offset = 2047 - offset;
+  uint8_t section = offset / 256;
+  uint16_t b = base[section];
+  uint8_t m = slope[section];
+  uint8_t secoffset8 = (uint8_t)(offset) / 2;
+  uint16_t mx = m * secoffset8;
+  int16_t y = mx + b;
+  if (theta & 0x8000) y = -y;
+  return y;
+}
+
+uint8_t sin8(uint8_t theta) {
+  static const uint8_t b_m16_interleave[] = { 0, 49, 49, 41, 90, 27, 117, 10 };
+  uint8_t offset = theta;
+  if (theta & 0x40) offset = (uint8_t)255 - offset;
+  offset &= 0x3F;
+  uint8_t secoffset = offset & 0x0F;
+  if (theta & 0x40) secoffset++;
+  uint8_t section = offset >> 4;
+  const uint8_t* p = b_m16_interleave + section * 2;
+  uint8_t b = p[0];
+  uint8_t m16 = p[1];
+  uint8_t mx = (m16 * secoffset) >> 4;
+  int8_t y = mx + b;
+  if (theta & 0x80) y = -y;
+  y += 128;
+  return y;
+}
+
+uint8_t sqrt16(uint16_t x) {
+  if (x <= 1) return x;
+  uint8_t low = 1;
+  uint8_t hi = x > 7904 ? 255 : (x >> 5) + 8;
+  do {
+    uint8_t mid = (low + hi) >> 1;
+    if ((uint16_t)(mid * mid) > x) hi = mid - 1;
+    else {
+      if (mid == 255) return 255;
+      low = mid + 1;
+    }
+  } while (hi >= low);
+  return low - 1;
+}
+
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb) {
+  uint8_t hue = hsv.hue;
+  uint8_t sat = hsv.sat;
+  uint8_t val = hsv.val;
+  uint8_t offset = hue & 0x1F;
+  uint8_t offset8 = offset << 3;
+  uint8_t third = scale8(offset8, (256 / 3));
+  uint8_t r, g, b;
+
+  if (!(hue & 0x80)) {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) { r = 255 - third; g = third; b = 0; }
+      else { r = 171; g = 85 + third; b = 0; }
+    } else {
+      if (!(hue & 0x20)) {
+        uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+        r = 171 - twothirds; g = 170 + third; b = 0;
+      } else { r = 0; g = 255 - third; b = third; }
+    }
+  } else {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) {
+        uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+        r = 0; g = 171 - twothirds; b = 85 + twothirds;
+      } else { r = third; g = 0; b = 255 - third; }
+    } else {
+      if (!(hue & 0x20)) { r = 85 + third; g = 0; b = 171 - third; }
+      else { r = 170 + third; g = 0; b = 85 - third; }
+    }
+  }
+
+  if (sat != 255) {
+    if (sat == 0) {
+      r = 255; b = 255; g = 255;
+    } else {
+      uint8_t desat = 255 - sat;
+      desat = scale8_video(desat, desat);
+      uint8_t satscale = 255 - desat;
+      if (r) r = scale8(r, satscale) + 1;
+      if (g) g = scale8(g, satscale) + 1;
+      if (b) b = scale8(b, satscale) + 1;
+      r += desat; g += desat; b += desat;
+    }
+  }
+
+  if (val != 255) {
+    val = scale8_video(val, val);
+    if (val == 0) {
+      r = 0; g = 0; b = 0;
+    } else {
+      if (r) r = scale8(r, val) + 1;
+      if (g) g = scale8(g, val) + 1;
+      if (b) b = scale8(b, val) + 1;
+    }
+  }
+
+  rgb.r = r; rgb.g = g; rgb.b = b;
+}
+
+CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2) {
+  CRGB out;
+  for (int i = 0; i < 3; i++) {
+    out.raw[i] = scale8(p1.raw[i], 255 - amountOfP2) + scale8(p2.raw[i], amountOfP2);
+  }
+  return out;
+}
+
+void fill_solid(CRGB* leds, int numToFill, const CRGB& color) {
+  for (int i = 0; i < numToFill; i++) leds[i] = color;
+}
+
+void fill_rainbow(CRGB* leds, int numToFill, uint8_t initialhue, uint8_t deltahue) {
+  CHSV hsv(initialhue, 240, 255);
+  for (int i = 0; i < numToFill; i++) {
+    leds[i] = hsv;
+    hsv.hue += deltahue;
+  }
+}
+
+void nscale8(CRGB* leds, uint16_t num_leds, uint8_t scale) {
+  for (uint16_t i = 0; i < num_leds; i++) leds[i].nscale8(scale);
+}
+
+void fadeToBlackBy(CRGB* leds, uint16_t num_leds, uint8_t fadeBy) { nscale8(leds, num_leds, 255 - fadeBy); }
+
+// ---------------------------------------------------------------- palettes
+const TProgmemRGBPalette16 HeatColors_p = {
+  0x000000, 0x330000, 0x660000, 0x990000, 0xCC0000, 0xFF0000, 0xFF3300, 0xFF6600,
+  0xFF9900, 0xFFCC00, 0xFFFF00, 0xFFFF33, 0xFFFF66, 0xFFFF99, 0xFFFFCC, 0xFFFFFF
+};
+const TProgmemRGBPalette16 PartyColors_p = {
+  0x5500AB, 0x84007C, 0xB5004B, 0xE5001B, 0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+  0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E, 0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9
+};
+const TProgmemRGBPalette16 RainbowColors_p = {
+  0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00, 0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+  0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5, 0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B
+};
+
+CRGBPalette16::CRGBPalette16(TProgmemRGBGradientPalette_byte* gradient) {
+  // Gradient entries are (index, r, g, b) ending with index 255
+  for (int i = 0; i < 16; i++) {
+    uint8_t pos = i * 17;
+    const uint8_t* lo = gradient;
+    const uint8_t* hi = gradient;
+    while (hi[0] < pos) { lo = hi; hi += 4; }
+    if (hi[0] == lo[0]) {
+      entries[i] = CRGB(hi[1], hi[2], hi[3]);
+    } else {
+      uint8_t f = (uint16_t)(pos - lo[0]) * 255 / (hi[0] - lo[0]);
+      entries[i] = CRGB(lerp8by8(lo[1], hi[1], f), lerp8by8(lo[2], hi[2], f), lerp8by8(lo[3], hi[3], f));
+    }
+  }
+}
+
+CRGB ColorFromPalette(const CRGBPalette16& pal, uint8_t index, uint8_t brightness, TBlendType blendType) {
+  uint8_t hi4 = index >> 4;
+  uint8_t lo4 = index & 0x0F;
+  CRGB c = pal[hi4];
+  if (lo4 && blendType != NOBLEND) {
+    const CRGB& next = pal[(hi4 + 1) & 0x0F];
+    uint8_t f2 = lo4 << 4;
+    uint8_t f1 = 255 - f2;
+    for (int i = 0; i < 3; i++) c.raw[i] = scale8(c.raw[i], f1) + scale8(next.raw[i], f2);
+  }
+  if (brightness != 255) c.nscale8_video(brightness);
+  return c;
+}
+
+// ---------------------------------------------------------------- controller
+void CFastLED::clear(bool writeData) {
+  for (int i = 0; i < count_; i++) fill_solid(controllers_[i].leds(), controllers_[i].size(), CRGB::Black);
+  if (writeData) show();
+}
@@ -0,0 +1,102 @@
+// Host implementation of the filesystem shim (shims/FS.h, shims/SPIFFS.h)
+#include <FS.h>
+#include <SPIFFS.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+SPIFFSFS SPIFFS;
+
+namespace fs {
+
+struct FileImpl {
+  FILE* fp = nullptr;
+  DIR* dir = nullptr;
+  std::string path;        // path on the device, e.g. /sprites/a.pxs
+  std::string hostPath;
+  const FS* owner = nullptr;
+
+  ~FileImpl() {
+    if (fp) fclose(fp);
+    if (dir) closedir(dir);
+  }
+};
+
+File::operator bool() const { return impl_ && (impl_->fp || impl_->dir); }
+
+size_t File::size() const {
+  struct stat st;
+  return impl_ && stat(impl_->hostPath.c_str(), &st) == 0 ? st.st_size : 0;
+}
+
+size_t File::position() const { return impl_ && impl_->fp ? ftell(impl_->fp) : 0; }
+
+int File::available() { return impl_ && impl_->fp ? (int)(size() - position()) : 0; }
+
+bool File::seek(uint32_t pos) { return impl_ && impl_->fp && fseek(impl_->fp, pos, SEEK_SET) == 0; }
+
+int File::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+  return impl_ && impl_->fp ? fread(buf, 1, size, impl_->fp) : 0;
+}
+
+size_t File::write(const uint8_t* buf, size_t size) {
+  return impl_ && impl_->fp ? fwrite(buf, 1, size, impl_->fp) : 0;
+}
+
+void File::close() { impl_.reset(); }
+
+bool File::isDirectory() const { return impl_ && impl_->dir; }
+
+File File::openNextFile(const char* mode) {
+  if (!isDirectory()) {
+    return File();
+  }
+  while (struct dirent* entry = readdir(impl_->dir)) {
+    if (entry->d_name[0] == '.') continue;
+    std::string path = impl_->path + "/" + entry->d_name;
+    return const_cast<FS*>(impl_->owner)->open(path.c_str(), mode);
+  }
+  return File();
+}
+
+const char* File::name() const {
+  if (!impl_) return "";
+  size_t slash = impl_->path.rfind('/');
+  return impl_->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+const char* File::path() const { return impl_ ? impl_->path.c_str() : ""; }
+
+File FS::open(const char* path, const char* mode) {
+  auto impl = std::make_shared<FileImpl>();
+  impl->path = path;
+  impl->hostPath = hostPath(path);
+  impl->owner = this;
+
+  struct stat st;
+  if (strcmp(mode, FILE_READ) == 0 && stat(impl->hostPath.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+    impl->dir = opendir(impl->hostPath.c_str());
+  } else {
+    // Binary mode, the sprite sheets are read byte for byte
+    std::string m = std::string(mode) + "b";
+    impl->fp = fopen(impl->hostPath.c_str(), m.c_str());
+  }
+  return (impl->fp || impl->dir) ? File(impl) : File();
+}
+
+bool FS::exists(const char* path) {
+  struct stat st;
+  return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) { return ::remove(hostPath(path).c_str()) == 0; }
+
+bool FS::rename(const char* from, const char* to) {
+  return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+} // namespace fs
@@ -0,0 +1,433 @@
+// Self-checks of the Game of Life and Tetris bitboards, run from the
+// simulator with --check (see sim_main.cpp). Each one compares the real
+// code with a reference that works on one cell at a time, simple enough
+// to be right by inspection.
+
+#include "self_check.h"
+#include <led_display.h>
+#include <patterns.h>
+#include "tetris/tetris_ai.h"
+#include <algorithm>
+#include <set>
+#include <vector>
+
+// Boards of the reference versions: one byte per cell, row by row
+typedef std::vector<uint8_t> Cells;
+
+// Random boards: xorshift like the shim's random(), with its own state so
+// the patterns' sequences are left alone
+static uint32_t nextRandom(uint32_t& state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+// -------------------------------------------------------------------
+// Game of Life
+// -------------------------------------------------------------------
+
+static bool lifeAlive(const Cells& cells, int x, int y, int width, int height) {
+  if (LIFE_WRAP) {
+    x = (x + width) % width;
+    y = (y + height) % height;
+  } else if (x < 0 || x >= width || y < 0 || y >= height) {
+    return false;
+  }
+  return cells[y * width + x];
+}
+
+// Conway's rules, counting each cell's eight neighbors one by one
+static Cells lifeReference(const Cells& cells, int width, int height) {
+  Cells next(cells.size());
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int neighbors = 0;
+      for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+          neighbors += (dx || dy) && lifeAlive(cells, x + dx, y + dy, width, height);
+        }
+      }
+      next[y * width + x] = neighbors == 3 || (neighbors == 2 && cells[y * width + x]);
+    }
+  }
+  return next;
+}
+
+static std::vector<uint32_t> lifePack(const Cells& cells, int width, int height) {
+  int words = (width + 31) / 32;
+  std::vector<uint32_t> board(words * height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      if (cells[y * width + x]) {
+        board[y * words + x / 32] |= 1u << (x % 32);
+      }
+    }
+  }
+  return board;
+}
+
+static void printBoard(const Cells& cells, int width, int height) {
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      putchar(cells[y * width + x] ? '#' : '.');
+    }
+    putchar('\n');
+  }
+}
+
+// lifeStep() on one board. On a mismatch, prints the board and returns false.
+static bool lifeCheckBoard(const Cells& cells, int width, int height) {
+  Cells expected = lifeReference(cells, width, height);
+  std::vector<uint32_t> board = lifePack(cells, width, height);
+  std::vector<uint32_t> next(board.size(), 0xdeadbeef);
+  uint16_t population = lifeStep(board.data(), next.data(), width, height);
+
+  uint16_t expectedPopulation = 0;
+  for (uint8_t cell : expected) {
+    expectedPopulation += cell;
+  }
+  // Compared as packed words, so stray bits past the last column count too
+  if (next == lifePack(expected, width, height) && population == expectedPopulation) {
+    return true;
+  }
+  printf("lifeStep: wrong next generation of this %dx%d board (population %u, expected %u):\n",
+         width, height, population, expectedPopulation);
+  printBoard(cells, width, height);
+  return false;
+}
+
+// Every size up to 70 cells across, where rows span up to three words and
+// the last word is partly used or exactly full, then the widest rows
+static bool lifeCheckSizes(uint32_t& rng) {
+  static const uint8_t densities[] = {32, 85, 128, 224};   // out of 256
+  uint32_t boards = 0;
+  std::vector<std::pair<int, int>> sizes;
+  for (int width = 1; width <= 70; width++) {
+    for (int height : {1, 2, 3, 5, 8}) {
+      sizes.push_back({width, height});
+    }
+  }
+  for (int width : {95, 96, 97, 128, 200, 255}) {
+    sizes.push_back({width, 4});
+  }
+  sizes.push_back({16, 16});
+  sizes.push_back({32, 32});
+
+  for (const std::pair<int, int>& size : sizes) {
+    int width = size.first, height = size.second;
+    Cells cells(width * height);
+    for (uint8_t density : densities) {
+      for (int i = 0; i < 4; i++) {
+        for (uint8_t& cell : cells) {
+          cell = (nextRandom(rng) & 0xff) < density;
+        }
+        if (!lifeCheckBoard(cells, width, height)) {
+          return false;
+        }
+        boards++;
+      }
+    }
+    // Only the outer cells and the columns either side of each word
+    // boundary, where the shifts carry cells across
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        cells[y * width + x] = x == 0 || y == 0 || x == width - 1 || y == height - 1 ||
+                               x % 32 == 0 || x % 32 == 31;
+      }
+    }
+    if (!lifeCheckBoard(cells, width, height)) {
+      return false;
+    }
+    boards++;
+  }
+  printf("lifeStep: %u boards on %u sizes match\n", (unsigned)boards, (unsigned)sizes.size());
+  return true;
+}
+
+// The pattern as displayed: every frame must be the next generation of the
+// one before, or a fresh board once the old one died, cycled or stopped
+// changing in number
+static bool lifeCheckPattern(CRGB* leds, uint32_t seed) {
+  int index = -1;
+  for (size_t i = 0; i < PATTERN_COUNT; i++) {
+    if (strcmp(g_patternList[i].name, "Game of Life") == 0) {
+      index = i;
+    }
+  }
+  if (index < 0) {
+    printf("meteorRain: Game of Life is not in the pattern list\n");
+    return false;
+  }
+
+  const int width = LED_WIDTH, height = LED_HEIGHT;
+  const int frames = 2000;
+  randomSeed(seed);
+  random16_set_seed(seed);
+  beginPattern(index);
+
+  std::vector<Cells> since;   // frames since the last reseed
+  uint32_t reseeds = 0;
+  bool ok = true;
+  for (int f = 0; f < frames && ok; f++) {
+    g_patternList[index].func(leds);
+    Cells cells(width * height);
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        cells[y * width + x] = leds[XY(x, y)] == CRGB(CRGB::White);
+      }
+    }
+
+    if (!since.empty() && cells != lifeReference(since.back(), width, height)) {
+      const Cells& last = since.back();
+      int lastPopulation = 0, beforePopulation = -1;
+      for (size_t i = 0; i < last.size(); i++) {
+        lastPopulation += last[i];
+      }
+      if (since.size() > 1) {
+        beforePopulation = 0;
+        for (uint8_t cell : since[since.size() - 2]) {
+          beforePopulation += cell;
+        }
+      }
+      bool repeated = false;
+      for (size_t i = 0; i + 1 < since.size(); i++) {
+        repeated |= since[i] == last;
+      }
+      if (lastPopulation == 0 || repeated || lastPopulation == beforePopulation) {
+        since.clear();
+        reseeds++;
+      } else {
+        printf("meteorRain: frame %d on %dx%d is neither the next generation nor a reseed, after:\n",
+               f, width, height);
+        printBoard(last, width, height);
+        ok = false;
+      }
+    }
+    since.push_back(cells);
+  }
+  endPattern(index);
+  if (ok) {
+    printf("meteorRain: %d frames on %dx%d match, %u reseeds\n", frames, width, height, (unsigned)reseeds);
+  }
+  return ok;
+}
+
+// -------------------------------------------------------------------
+// Tetris bitboards
+// -------------------------------------------------------------------
+
+typedef std::vector<std::pair<int, int>> TetrisCells;   // (x, y), sorted
+
+// The piece's cells on the board, turning its 4x4 grid clockwise as the
+// game's rotateTetromino() does
+static TetrisCells tetrisCells(const TetrisPiece& piece) {
+  uint8_t grid[4][4];
+  memcpy(grid, TETROMINOS[piece.type], sizeof(grid));
+  for (uint8_t turn = 0; turn < piece.rotation; turn++) {
+    uint8_t turned[4][4];
+    for (int y = 0; y < 4; y++) {
+      for (int x = 0; x < 4; x++) {
+        turned[x][3 - y] = grid[y][x];
+      }
+    }
+    memcpy(grid, turned, sizeof(grid));
+  }
+  TetrisCells cells;
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      if (grid[y][x]) {
+        cells.push_back({piece.x + x, piece.y + y});
+      }
+    }
+  }
+  std::sort(cells.begin(), cells.end());
+  return cells;
+}
+
+static bool tetrisFilled(const TetrisBoard& board, int x, int y) {
+  return (board.rows[y] >> x) & 1;
+}
+
+static bool tetrisReferenceCollides(const TetrisBoard& board, const TetrisPiece& piece) {
+  for (const std::pair<int, int>& c : tetrisCells(piece)) {
+    if (c.first < 0 || c.first >= TETRIS_COLS || c.second < 0 || c.second >= TETRIS_ROWS ||
+        tetrisFilled(board, c.first, c.second)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Set the piece's cells, then clear full rows one at a time from the
+// bottom, moving every row above down by one
+static uint8_t tetrisReferenceLock(TetrisBoard& board, const TetrisPiece& piece) {
+  for (const std::pair<int, int>& c : tetrisCells(piece)) {
+    board.rows[c.second] |= 1 << c.first;
+  }
+  uint8_t lines = 0;
+  for (int y = TETRIS_ROWS - 1; y >= 0;) {
+    bool full = true;
+    for (int x = 0; x < TETRIS_COLS; x++) {
+      full = full && tetrisFilled(board, x, y);
+    }
+    if (!full) {
+      y--;
+      continue;
+    }
+    for (int above = y; above > 0; above--) {
+      board.rows[above] = board.rows[above - 1];
+    }
+    board.rows[0] = 0;
+    lines++;
+  }
+  return lines;
+}
+
+static void printTetris(const TetrisBoard& board, const TetrisPiece& piece) {
+  printf("piece %u, rotation %u at (%d, %d) on\n", piece.type, piece.rotation, piece.x, piece.y);
+  for (int y = 0; y < TETRIS_ROWS; y++) {
+    for (int x = 0; x < TETRIS_COLS; x++) {
+      putchar(tetrisFilled(board, x, y) ? '#' : '.');
+    }
+    putchar('\n');
+  }
+}
+
+// A random board: columns of random height with some holes, and rows
+// near the bottom that are often one cell short of full, so locks clear
+// lines
+static TetrisBoard tetrisRandomBoard(uint32_t& rng) {
+  TetrisBoard board = {};
+  int top = TETRIS_ROWS - nextRandom(rng) % (TETRIS_ROWS - 2);
+  for (int y = top; y < TETRIS_ROWS; y++) {
+    if (nextRandom(rng) % 2) {
+      board.rows[y] = TETRIS_FULL_ROW & ~(1 << nextRandom(rng) % TETRIS_COLS);
+    } else {
+      board.rows[y] = nextRandom(rng) & nextRandom(rng) & TETRIS_FULL_ROW;
+    }
+  }
+  return board;
+}
+
+// tetrisCollides() and tetrisLock() for every piece and rotation at every
+// position in and around random boards
+static bool tetrisCheckLock(uint32_t& rng) {
+  const int boards = 200;
+  uint32_t locks = 0, lines = 0;
+  for (int b = 0; b < boards; b++) {
+    TetrisBoard board = tetrisRandomBoard(rng);
+    for (uint8_t type = 0; type < TETRIS_PIECES; type++) {
+      for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        for (int8_t y = -4; y <= TETRIS_ROWS; y++) {
+          for (int8_t x = -4; x <= TETRIS_COLS; x++) {
+            TetrisPiece piece = {type, rotation, x, y};
+            bool collides = tetrisReferenceCollides(board, piece);
+            if (tetrisCollides(board, piece) != collides) {
+              printf("tetrisCollides: should be %s for ", collides ? "true" : "false");
+              printTetris(board, piece);
+              return false;
+            }
+            if (collides) {
+              continue;
+            }
+            TetrisBoard locked = board, expected = board;
+            uint8_t cleared = tetrisLock(locked, piece);
+            uint8_t expectedLines = tetrisReferenceLock(expected, piece);
+            if (cleared != expectedLines || memcmp(&locked, &expected, sizeof(locked))) {
+              printf("tetrisLock: cleared %u lines, expected %u, or left the wrong board for ",
+                     cleared, expectedLines);
+              printTetris(board, piece);
+              return false;
+            }
+            locks++;
+            lines += cleared;
+          }
+        }
+      }
+    }
+  }
+  printf("tetrisLock: %u locks on %d boards match, %u lines cleared\n", (unsigned)locks, boards, (unsigned)lines);
+  return true;
+}
+
+// Where `piece` locks when the AI plays `plan` out: its moves, then a
+// straight drop once lined up
+static TetrisPiece tetrisPlayPlan(const TetrisBoard& board, TetrisPiece piece, const TetrisPlan& plan) {
+  while (tetrisAIStep(plan, piece) != T_DOWN) {
+    if (!tetrisAIAdvance(board, plan, piece)) {
+      return piece;
+    }
+  }
+  for (TetrisPiece lower = piece; lower.y++, !tetrisCollides(board, lower);) {
+    piece = lower;
+  }
+  return piece;
+}
+
+// The planner's placements: it tries every rotation and target column and
+// drops those that end on the same cells as another, keyed by the shape's
+// id and position. Count the distinct cell sets the same plans reach and
+// compare with what the planner reports.
+static bool tetrisCheckPlacements(uint32_t& rng) {
+  const int boards = 300;
+  uint32_t placements = 0, plans = 0;
+  for (int b = 0; b < boards; b++) {
+    TetrisBoard board = b == 0 ? TetrisBoard{} : tetrisRandomBoard(rng);
+    for (uint8_t type = 0; type < TETRIS_PIECES; type++) {
+      for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        TetrisPiece piece = tetrisSpawn(type);
+        piece.rotation = rotation;
+        if (tetrisCollides(board, piece)) {
+          continue;
+        }
+
+        std::set<TetrisCells> ends;
+        for (uint8_t turns = 0; turns < 4; turns++) {
+          for (int8_t x = -3; x < TETRIS_COLS; x++) {
+            TetrisPlan plan = {};
+            plan.rotation = (rotation + turns) % 4;
+            plan.targetX = x;
+            // Only targets where the turned piece fits between the walls
+            if (!tetrisReferenceCollides(TetrisBoard{}, TetrisPiece{type, plan.rotation, x, 4})) {
+              ends.insert(tetrisCells(tetrisPlayPlan(board, piece, plan)));
+            }
+          }
+        }
+
+        TetrisPlan plan;
+        TetrisAIStats stats = {};
+        bool found = tetrisAIPlan(board, piece, -1, TETRIS_DEFAULT_WEIGHTS, &plan, &stats);
+        if (!found || stats.placements != ends.size() || stats.evaluations != stats.placements) {
+          printf("tetrisAIPlan: %u placements, expected %u, for ", stats.placements, (unsigned)ends.size());
+          printTetris(board, piece);
+          return false;
+        }
+        // The plan it picked lands where it says
+        TetrisPiece end = tetrisPlayPlan(board, piece, plan);
+        if (end.y != plan.landingY) {
+          printf("tetrisAIPlan: plan to land on row %d ends on row %d for ", plan.landingY, end.y);
+          printTetris(board, piece);
+          return false;
+        }
+        placements += stats.placements;
+        plans++;
+      }
+    }
+  }
+  printf("tetrisAIPlan: %u plans on %d boards match, %u distinct placements\n",
+         (unsigned)plans, boards, (unsigned)placements);
+  return true;
+}
+
+// -------------------------------------------------------------------
+
+int selfCheck(CRGB* leds, uint32_t seed) {
+  uint32_t rng = seed * 2654435761u + 1;
+  bool ok = lifeCheckSizes(rng);
+  ok = lifeCheckPattern(leds, seed) && ok;
+  ok = tetrisCheckLock(rng) && ok;
+  ok = tetrisCheckPlacements(rng) && ok;
+  printf(ok ? "All checks passed\n" : "Check failed\n");
+  return ok ? 0 : 1;
+}
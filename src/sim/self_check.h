@@ -0,0 +1,23 @@
+#ifndef SELF_CHECK_H
+#define SELF_CHECK_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+// Checks the bit-twiddling in the patterns against plain, cell by cell
+// versions of the same rules, run from the simulator with --check:
+//
+//   lifeStep()      every board size from 1x1 up to the widest rows, with
+//                   random boards of several densities and edge-only boards
+//   meteorRain()    the Game of Life pattern as displayed on the simulated
+//                   geometry, generation by generation
+//   tetrisLock()    and tetrisCollides(), every piece at every position on
+//                   random boards: lines cleared and the board left behind
+//   tetrisAIPlan()  the placements left once duplicates (the same cells
+//                   reached by another rotation or column) are dropped
+//
+// Boards come from `seed`, so a failure repeats. Prints one line per check
+// and the first case that failed. Returns the process exit code.
+int selfCheck(CRGB* leds, uint32_t seed);
+
+#endif // SELF_CHECK_H
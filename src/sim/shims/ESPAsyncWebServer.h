@@ -0,0 +1,235 @@
+// Host shim for ESPAsyncWebServer. Handlers are recorded so the simulator
+// can invoke endpoints directly; responses are captured instead of sent.
+#ifndef SIM_ESPASYNCWEBSERVER_H
+#define SIM_ESPASYNCWEBSERVER_H
+
+#include <Arduino.h>
+#include <functional>
+#include <map>
+#include <vector>
+
+typedef enum {
+  HTTP_GET = 0b00000001,
+  HTTP_POST = 0b00000010,
+  HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebParameter {
+public:
+  AsyncWebParameter(const String& name, const String& value) : name_(name), value_(value) {}
+  const String& name() const { return name_; }
+  const String& value() const { return value_; }
+private:
+  String name_;
+  String value_;
+};
+
+class AsyncWebHeader {
+public:
+  AsyncWebHeader(const String& name, const String& value) : name_(name), value_(value) {}
+  const String& name() const { return name_; }
+  const String& value() const { return value_; }
+private:
+  String name_;
+  String value_;
+};
+
+class AsyncWebServerResponse {
+public:
+  AsyncWebServerResponse(int code, const String& contentType, std::vector<uint8_t> body)
+    : code_(code), contentType_(contentType), body_(std::move(body)) {}
+  void addHeader(const String& name, const String& value) { headers_[name.str()] = value; }
+  void setCode(int code) { code_ = code; }
+  int code() const { return code_; }
+  const String& contentType() const { return contentType_; }
+  const std::vector<uint8_t>& body() const { return body_; }
+  const std::map<std::string, String>& headers() const { return headers_; }
+private:
+  int code_;
+  String contentType_;
+  std::vector<uint8_t> body_;
+  std::map<std::string, String> headers_;
+};
+
+typedef std::function<size_t(uint8_t* buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+
+class AsyncWebServerRequest {
+public:
+  explicit AsyncWebServerRequest(const String& url) : url_(url) {}
+  ~AsyncWebServerRequest() { delete response_; }
+
+  void addParam(const String& name, const String& value) { params_.emplace_back(name, value); }
+  void addHeader(const String& name, const String& value) { headers_.emplace_back(name, value); }
+  bool hasHeader(const String& name) const { return findHeader(name) != nullptr; }
+  AsyncWebHeader* getHeader(const String& name) { return const_cast<AsyncWebHeader*>(findHeader(name)); }
+  bool hasParam(const String& name, bool post = false) const { return findParam(name) != nullptr; }
+  AsyncWebParameter* getParam(const String& name, bool post = false) { return const_cast<AsyncWebParameter*>(findParam(name)); }
+  bool hasArg(const char* name) const { return findParam(name) != nullptr; }
+  String arg(const char* name) const { const AsyncWebParameter* p = findParam(name); return p ? p->value() : String(); }
+  const String& url() const { return url_; }
+  void onDisconnect(std::function<void()> fn) { onDisconnect_ = fn; }
+  std::function<void()> onDisconnect_;
+
+  void send(int code, const String& contentType = String(), const String& content = String()) {
+    const std::string& s = content.str();
+    send(new AsyncWebServerResponse(code, contentType, std::vector<uint8_t>(s.begin(), s.end())));
+  }
+  void send(AsyncWebServerResponse* response) { delete response_; response_ = response; }
+  AsyncWebServerResponse* beginResponse(int code, const String& contentType = String(), const String& content = String()) {
+    const std::string& s = content.str();
+    return new AsyncWebServerResponse(code, contentType, std::vector<uint8_t>(s.begin(), s.end()));
+  }
+  AsyncWebServerResponse* beginResponse(int code, const String& contentType, const uint8_t* content, size_t len) {
+    return new AsyncWebServerResponse(code, contentType, std::vector<uint8_t>(content, content + len));
+  }
+  AsyncWebServerResponse* beginResponse_P(int code, const String& contentType, const uint8_t* content, size_t len) {
+    return beginResponse(code, contentType, content, len);
+  }
+  AsyncWebServerResponse* beginResponse(const String& contentType, size_t len, AwsResponseFiller filler) {
+    std::vector<uint8_t> body(len);
+    size_t index = 0;
+    while (index < len) {
+      size_t n = filler(body.data() + index, len - index, index);
+      if (n == 0) break;
+      index += n;
+    }
+    body.resize(index);
+    return new AsyncWebServerResponse(200, contentType, std::move(body));
+  }
+
+  AsyncWebServerResponse* response() const { return response_; }
+
+private:
+  const AsyncWebParameter* findParam(const String& name) const {
+    for (const AsyncWebParameter& p : params_) if (p.name() == name) return &p;
+    return nullptr;
+  }
+  const AsyncWebHeader* findHeader(const String& name) const {
+    for (const AsyncWebHeader& h : headers_) if (strcasecmp(h.name().c_str(), name.c_str()) == 0) return &h;
+    return nullptr;
+  }
+  String url_;
+  std::vector<AsyncWebParameter> params_;
+  std::vector<AsyncWebHeader> headers_;
+  AsyncWebServerResponse* response_ = nullptr;
+};
+
+typedef std::function<void(AsyncWebServerRequest*)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest*, const String&, size_t, uint8_t*, size_t, bool)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest*, uint8_t*, size_t, size_t, size_t)> ArBodyHandlerFunction;
+
+class AsyncStaticWebHandler {
+public:
+  AsyncStaticWebHandler& setCacheControl(const char*) { return *this; }
+  AsyncStaticWebHandler& setDefaultFile(const char*) { return *this; }
+};
+
+class AsyncCallbackWebHandler {};
+
+class AsyncWebHandler {
+public:
+  virtual ~AsyncWebHandler() {}
+};
+
+// WebSockets: enough of the API for the firmware to build. Messages sent to
+// clients are dropped; simReceive() delivers one from a pretend client.
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+typedef enum { WS_CONTINUATION, WS_TEXT, WS_BINARY, WS_DISCONNECT = 0x08, WS_PING, WS_PONG } AwsFrameType;
+
+typedef struct {
+  uint8_t message_opcode;
+  uint32_t num;
+  uint8_t final;
+  uint8_t masked;
+  uint8_t opcode;
+  uint64_t len;
+  uint8_t mask[4];
+  uint64_t index;
+} AwsFrameInfo;
+
+typedef enum { WS_DISCONNECTED, WS_CONNECTED, WS_DISCONNECTING } AwsClientStatus;
+
+class AsyncWebSocket;
+
+class AsyncWebSocketClient {
+public:
+  AsyncWebSocketClient(AsyncWebSocket* server, uint32_t id) : server_(server), id_(id) {}
+  uint32_t id() const { return id_; }
+  AsyncWebSocket* server() const { return server_; }
+  AwsClientStatus status() const { return WS_CONNECTED; }
+  bool queueIsFull() const { return false; }
+  void text(const char* message) {}
+  void text(const String& message) {}
+  void binary(const uint8_t* message, size_t len) {}
+  void close() {}
+private:
+  AsyncWebSocket* server_;
+  uint32_t id_;
+};
+
+typedef std::function<void(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type,
+                           void* arg, uint8_t* data, size_t len)> AwsEventHandler;
+
+class AsyncWebSocket : public AsyncWebHandler {
+public:
+  explicit AsyncWebSocket(const char* url) : url_(url) {}
+  void onEvent(AwsEventHandler handler) { handler_ = handler; }
+  const char* url() const { return url_; }
+  size_t count() const { return 0; }
+  void cleanupClients(uint16_t maxClients = 8) {}
+  void textAll(const char* message) {}
+  void textAll(const String& message) {}
+  void binaryAll(const uint8_t* message, size_t len) {}
+  AsyncWebSocketClient* client(uint32_t id) { return nullptr; }
+
+  // Simulator entry point: one whole message from client `id`
+  void simReceive(uint32_t id, const uint8_t* data, size_t len, bool binary = true) {
+    if (!handler_) return;
+    AsyncWebSocketClient client(this, id);
+    AwsFrameInfo info = {};
+    info.message_opcode = info.opcode = binary ? WS_BINARY : WS_TEXT;
+    info.final = 1;
+    info.len = len;
+    handler_(this, &client, WS_EVT_DATA, &info, const_cast<uint8_t*>(data), len);
+  }
+private:
+  const char* url_;
+  AwsEventHandler handler_;
+};
+
+namespace fs { class FS; }
+
+class AsyncWebServer {
+public:
+  explicit AsyncWebServer(uint16_t port) {}
+  AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                              ArUploadHandlerFunction onUpload = nullptr, ArBodyHandlerFunction onBody = nullptr) {
+    routes_[uri] = Route{method, onRequest, onBody};
+    return handler_;
+  }
+  AsyncWebHandler& addHandler(AsyncWebHandler* handler) { return *handler; }
+  AsyncStaticWebHandler& serveStatic(const char*, fs::FS&, const char*, const char* = nullptr) { return static_; }
+  void begin() {}
+
+  // Simulator entry point: run the handler registered for `request->url()`.
+  bool dispatch(AsyncWebServerRequest* request, const uint8_t* body = nullptr, size_t len = 0) {
+    auto it = routes_.find(request->url().str());
+    if (it == routes_.end()) return false;
+    if (body && it->second.onBody) it->second.onBody(request, const_cast<uint8_t*>(body), len, 0, len);
+    if (it->second.onRequest) it->second.onRequest(request);
+    return true;
+  }
+
+private:
+  struct Route {
+    WebRequestMethodComposite method;
+    ArRequestHandlerFunction onRequest;
+    ArBodyHandlerFunction onBody;
+  };
+  std::map<std::string, Route> routes_;
+  AsyncCallbackWebHandler handler_;
+  AsyncStaticWebHandler static_;
+};
+
+#endif // SIM_ESPASYNCWEBSERVER_H
@@ -0,0 +1,66 @@
+// Host shim for the Arduino-ESP32 filesystem API. Paths are looked up in a
+// directory on the host (data/ by default), the same tree that
+// `pio run -t uploadfs` puts on SPIFFS.
+#ifndef SIM_FS_H
+#define SIM_FS_H
+
+#include <Arduino.h>
+#include <memory>
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+struct FileImpl;
+
+class File {
+public:
+  File() {}
+  explicit File(std::shared_ptr<FileImpl> impl) : impl_(impl) {}
+
+  explicit operator bool() const;
+  size_t size() const;
+  size_t position() const;
+  int available();
+  bool seek(uint32_t pos);
+  int read();
+  size_t read(uint8_t* buf, size_t size);
+  size_t write(const uint8_t* buf, size_t size);
+  size_t write(uint8_t c) { return write(&c, 1); }
+  void close();
+  bool isDirectory() const;
+  File openNextFile(const char* mode = FILE_READ);
+  const char* name() const;
+  const char* path() const;
+
+private:
+  std::shared_ptr<FileImpl> impl_;
+};
+
+class FS {
+public:
+  File open(const char* path, const char* mode = FILE_READ);
+  File open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+  bool exists(const char* path);
+  bool exists(const String& path) { return exists(path.c_str()); }
+  bool remove(const char* path);
+  bool remove(const String& path) { return remove(path.c_str()); }
+  bool rename(const char* from, const char* to);
+  bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+
+  // Host directory the filesystem root maps to
+  void setRoot(const char* dir) { root_ = dir; }
+  std::string hostPath(const char* path) const { return root_ + path; }
+
+private:
+  std::string root_ = "data";
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif // SIM_FS_H
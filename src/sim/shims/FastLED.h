@@ -0,0 +1,200 @@
+// Host shim for the subset of FastLED used by PixelBoard. The 8/16-bit math
+// follows FastLED's portable C implementations so patterns render the same
+// colors as on the device.
+#ifndef SIM_FASTLED_H
+#define SIM_FASTLED_H
+
+#include <Arduino.h>
+
+typedef uint8_t fract8;
+typedef uint16_t fract16;
+typedef uint16_t accum88;
+
+// ---------------------------------------------------------------- 8-bit math
+inline uint8_t qadd8(uint8_t i, uint8_t j) { unsigned t = i + j; return t > 255 ? 255 : t; }
+inline uint8_t qsub8(uint8_t i, uint8_t j) { int t = i - j; return t < 0 ? 0 : t; }
+inline uint8_t scale8(uint8_t i, fract8 scale) { return (((uint16_t)i) * (1 + (uint16_t)scale)) >> 8; }
+inline uint8_t scale8_video(uint8_t i, fract8 scale) { return (((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0); }
+inline uint16_t scale16(uint16_t i, fract16 scale) { return ((uint32_t)i * (1 + (uint32_t)scale)) >> 16; }
+inline uint8_t lerp8by8(uint8_t a, uint8_t b, fract8 frac) {
+  return b > a ? a + scale8(b - a, frac) : a - scale8(a - b, frac);
+}
+
+int16_t sin16(uint16_t theta);
+inline int16_t cos16(uint16_t theta) { return sin16(theta + 16384); }
+uint8_t sin8(uint8_t theta);
+inline uint8_t cos8(uint8_t theta) { return sin8(theta + 64); }
+uint8_t sqrt16(uint16_t x);
+
+// ---------------------------------------------------------------- random
+extern uint16_t rand16seed;
+inline uint8_t random8() { rand16seed = (rand16seed * 2053) + 13849; return (uint8_t)(((uint8_t)(rand16seed & 0xFF)) + ((uint8_t)(rand16seed >> 8))); }
+inline uint8_t random8(uint8_t lim) { return (random8() * lim) >> 8; }
+inline uint8_t random8(uint8_t min, uint8_t lim) { return min + random8(lim - min); }
+inline uint16_t random16() { rand16seed = (rand16seed * 2053) + 13849; return rand16seed; }
+inline uint16_t random16(uint16_t lim) { return ((uint32_t)random16() * lim) >> 16; }
+inline uint16_t random16(uint16_t min, uint16_t lim) { return min + random16(lim - min); }
+inline void random16_set_seed(uint16_t seed) { rand16seed = seed; }
+
+// ---------------------------------------------------------------- beats
+inline uint16_t beat88(accum88 bpm88, uint32_t timebase = 0) { return ((millis() - timebase) * bpm88 * 280) >> 16; }
+inline uint16_t beat16(accum88 bpm, uint32_t timebase = 0) { if (bpm < 256) bpm <<= 8; return beat88(bpm, timebase); }
+inline uint8_t beat8(accum88 bpm, uint32_t timebase = 0) { return beat16(bpm, timebase) >> 8; }
+inline uint16_t beatsin16(accum88 bpm, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phase = 0) {
+  uint16_t beat = beat16(bpm, timebase);
+  uint16_t beatsin = sin16(beat + phase) + 32768;
+  return lowest + scale16(beatsin, highest - lowest);
+}
+inline uint8_t beatsin8(accum88 bpm, uint8_t lowest = 0, uint8_t highest = 255, uint32_t timebase = 0, uint8_t phase = 0) {
+  uint8_t beat = beat8(bpm, timebase);
+  uint8_t beatsin = sin8(beat + phase);
+  return lowest + scale8(beatsin, highest - lowest);
+}
+
+// ---------------------------------------------------------------- colors
+struct CHSV {
+  union { uint8_t hue; uint8_t h; };
+  uint8_t sat, val;
+  CHSV() : hue(0), sat(0), val(0) {}
+  CHSV(uint8_t ih, uint8_t is, uint8_t iv) : hue(ih), sat(is), val(iv) {}
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB {
+  union {
+    struct { uint8_t r, g, b; };
+    uint8_t raw[3];
+  };
+
+  CRGB() : r(0), g(0), b(0) {}
+  CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+  CRGB(long colorcode) : CRGB((uint32_t)colorcode) {}
+  CRGB(int colorcode) : CRGB((uint32_t)colorcode) {}
+  CRGB(const CHSV& hsv) { hsv2rgb_rainbow(hsv, *this); }
+
+  CRGB& operator=(uint32_t colorcode) { *this = CRGB(colorcode); return *this; }
+  CRGB& operator=(long colorcode) { *this = CRGB((uint32_t)colorcode); return *this; }
+  CRGB& operator=(const CHSV& hsv) { hsv2rgb_rainbow(hsv, *this); return *this; }
+
+  uint8_t& operator[](uint8_t x) { return raw[x]; }
+  const uint8_t& operator[](uint8_t x) const { return raw[x]; }
+
+  CRGB& operator+=(const CRGB& o) { r = qadd8(r, o.r); g = qadd8(g, o.g); b = qadd8(b, o.b); return *this; }
+  CRGB& operator-=(const CRGB& o) { r = qsub8(r, o.r); g = qsub8(g, o.g); b = qsub8(b, o.b); return *this; }
+  CRGB& operator|=(const CRGB& o) { if (o.r > r) r = o.r; if (o.g > g) g = o.g; if (o.b > b) b = o.b; return *this; }
+  CRGB& nscale8(uint8_t s) { r = scale8(r, s); g = scale8(g, s); b = scale8(b, s); return *this; }
+  CRGB& nscale8_video(uint8_t s) { r = scale8_video(r, s); g = scale8_video(g, s); b = scale8_video(b, s); return *this; }
+  CRGB& fadeToBlackBy(uint8_t f) { return nscale8(255 - f); }
+  CRGB& maximizeBrightness(uint8_t limit = 255) {
+    uint8_t m = std::max(r, std::max(g, b));
+    if (m == 0) return *this;
+    uint16_t factor = ((uint16_t)limit * 256) / m;
+    r = (r * factor) / 256; g = (g * factor) / 256; b = (b * factor) / 256;
+    return *this;
+  }
+  explicit operator bool() const { return r || g || b; }
+  bool operator==(const CRGB& o) const { return r == o.r && g == o.g && b == o.b; }
+  bool operator!=(const CRGB& o) const { return !(*this == o); }
+
+  typedef enum {
+    Black = 0x000000, Blue = 0x0000FF, Cyan = 0x00FFFF, Green = 0x008000,
+    Orange = 0xFFA500, Purple = 0x800080, Red = 0xFF0000, White = 0xFFFFFF,
+    Yellow = 0xFFFF00, Pink = 0xFFC0CB, Magenta = 0xFF00FF, Gray = 0x808080
+  } HTMLColorCode;
+  CRGB(HTMLColorCode c) : CRGB((uint32_t)c) {}
+  CRGB& operator=(HTMLColorCode c) { *this = CRGB((uint32_t)c); return *this; }
+};
+
+inline CRGB operator+(const CRGB& a, const CRGB& b) { CRGB r(a); r += b; return r; }
+
+CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2);
+
+void fill_solid(CRGB* leds, int numToFill, const CRGB& color);
+void fill_rainbow(CRGB* leds, int numToFill, uint8_t initialhue, uint8_t deltahue = 5);
+void fadeToBlackBy(CRGB* leds, uint16_t num_leds, uint8_t fadeBy);
+void nscale8(CRGB* leds, uint16_t num_leds, uint8_t scale);
+
+// ---------------------------------------------------------------- palettes
+typedef uint32_t TProgmemRGBPalette16[16];
+typedef const uint8_t TProgmemRGBGradientPalette_byte;
+typedef enum { NOBLEND = 0, LINEARBLEND = 1 } TBlendType;
+
+struct CRGBPalette16 {
+  CRGB entries[16];
+  CRGBPalette16() {}
+  CRGBPalette16(const TProgmemRGBPalette16& rhs) { for (int i = 0; i < 16; i++) entries[i] = CRGB(rhs[i]); }
+  CRGBPalette16(TProgmemRGBGradientPalette_byte* gradient);
+  CRGB& operator[](uint8_t x) { return entries[x]; }
+  const CRGB& operator[](uint8_t x) const { return entries[x]; }
+};
+
+extern const TProgmemRGBPalette16 HeatColors_p;
+extern const TProgmemRGBPalette16 PartyColors_p;
+extern const TProgmemRGBPalette16 RainbowColors_p;
+
+CRGB ColorFromPalette(const CRGBPalette16& pal, uint8_t index, uint8_t brightness = 255, TBlendType blendType = LINEARBLEND);
+
+// ---------------------------------------------------------------- timers
+class CEveryNMillis {
+public:
+  explicit CEveryNMillis(uint32_t period) : period_(period), prev_(millis()) {}
+  explicit operator bool() {
+    uint32_t now = millis();
+    if (now - prev_ >= period_) { prev_ = now; return true; }
+    return false;
+  }
+private:
+  uint32_t period_;
+  uint32_t prev_;
+};
+#define SIM_CONCAT_(a, b) a##b
+#define SIM_CONCAT(a, b) SIM_CONCAT_(a, b)
+#define EVERY_N_MILLISECONDS(N) static CEveryNMillis SIM_CONCAT(everyN_, __LINE__)(N); if (SIM_CONCAT(everyN_, __LINE__))
+#define EVERY_N_MILLIS(N) EVERY_N_MILLISECONDS(N)
+#define EVERY_N_SECONDS(N) EVERY_N_MILLISECONDS((N) * 1000UL)
+
+// ---------------------------------------------------------------- controller
+enum EOrder { RGB = 0012, GRB = 0102, BRG = 0201 };
+enum LEDColorCorrection { TypicalLEDStrip = 0xFFB0F0, UncorrectedColor = 0xFFFFFF };
+template <uint8_t DATA_PIN, EOrder RGB_ORDER> class WS2811 {};
+template <uint8_t DATA_PIN, EOrder RGB_ORDER> class WS2812B {};
+
+class CLEDController {
+public:
+  CLEDController& setCorrection(LEDColorCorrection) { return *this; }
+  CLEDController& setLeds(CRGB* data, int nLeds) { leds_ = data; count_ = nLeds; return *this; }
+  CRGB* leds() { return leds_; }
+  int size() const { return count_; }
+private:
+  CRGB* leds_ = nullptr;
+  int count_ = 0;
+};
+
+class CFastLED {
+public:
+  template <template <uint8_t, EOrder> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+  CLEDController& addLeds(CRGB* data, int nLeds, int offset = 0) {
+    CLEDController& c = controllers_[count_ < 8 ? count_++ : 7];
+    return c.setLeds(data + offset, nLeds);
+  }
+  void setBrightness(uint8_t scale) { brightness_ = scale; }
+  uint8_t getBrightness() const { return brightness_; }
+  // There is no strip to clock out; the simulator reads the frames that
+  // the patterns hand to led_present() instead
+  void show() {}
+  void show(uint8_t) {}
+  void delay(unsigned long ms) { ::delay(ms); }
+  void clear(bool writeData = false);
+  int count() const { return count_; }
+  CLEDController& operator[](int x) { return controllers_[x]; }
+private:
+  CLEDController controllers_[8];
+  int count_ = 0;
+  uint8_t brightness_ = 255;
+};
+extern CFastLED FastLED;
+
+#endif // SIM_FASTLED_H
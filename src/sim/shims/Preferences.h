@@ -0,0 +1,30 @@
+// Host shim for the NVS Preferences API. Nothing is stored, every getter
+// returns its default, so the simulator always starts from the compiled-in
+// settings (sim_main sets the display geometry directly).
+#ifndef SIM_PREFERENCES_H
+#define SIM_PREFERENCES_H
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false) { return true; }
+  void end() {}
+  bool clear() { return true; }
+  bool remove(const char* key) { return true; }
+  bool isKey(const char* key) { return false; }
+
+  int32_t getInt(const char* key, int32_t def = 0) { return def; }
+  uint8_t getUChar(const char* key, uint8_t def = 0) { return def; }
+  bool getBool(const char* key, bool def = false) { return def; }
+  String getString(const char* key, const String& def = String()) { return def; }
+  size_t getBytes(const char* key, void* buf, size_t len) { return 0; }
+
+  size_t putInt(const char* key, int32_t value) { return 4; }
+  size_t putUChar(const char* key, uint8_t value) { return 1; }
+  size_t putBool(const char* key, bool value) { return 1; }
+  size_t putString(const char* key, const String& value) { return value.length(); }
+  size_t putBytes(const char* key, const void* buf, size_t len) { return len; }
+};
+
+#endif // SIM_PREFERENCES_H
@@ -0,0 +1,16 @@
+// Host shim for SPIFFS, backed by a directory (see FS.h)
+#ifndef SIM_SPIFFS_H
+#define SIM_SPIFFS_H
+
+#include <FS.h>
+
+class SPIFFSFS : public fs::FS {
+public:
+  bool begin(bool formatOnFail = false) { return true; }
+  void end() {}
+  size_t totalBytes() { return 0; }
+  size_t usedBytes() { return 0; }
+};
+extern SPIFFSFS SPIFFS;
+
+#endif // SIM_SPIFFS_H
@@ -0,0 +1,21 @@
+// Host shim for arduinoFFT: the simulator has no microphone, so the audio
+// pattern only needs this to compile.
+#ifndef SIM_ARDUINOFFT_H
+#define SIM_ARDUINOFFT_H
+
+#include <stdint.h>
+
+enum FFTWindow { FFT_WIN_TYP_HAMMING };
+enum FFTDirection { FFT_FORWARD, FFT_REVERSE };
+
+template <typename T>
+class ArduinoFFT {
+public:
+  ArduinoFFT(T* vReal, T* vImag, uint16_t samples, T samplingFrequency) {}
+  void dcRemoval(T* vData, uint16_t samples) {}
+  void windowing(T* vData, uint16_t samples, FFTWindow windowType, FFTDirection dir) {}
+  void compute(T* vReal, T* vImag, uint16_t samples, FFTDirection dir) {}
+  void complexToMagnitude(T* vReal, T* vImag, uint16_t samples) {}
+};
+
+#endif // SIM_ARDUINOFFT_H
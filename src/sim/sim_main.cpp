@@ -0,0 +1,361 @@
+// Host-native simulator. Runs the patterns in g_patternList headless on a
+// workstation, against the shims in src/sim/shims, so they can be profiled
+// and regression tested without an ESP32. Build and run with
+//
+//   pio run -e native
+//   .pio/build/native/program --help
+//
+// Time is virtual: each frame advances the clock by the delay the pattern
+// asked for, and the random generators are reseeded before every pattern,
+// so the same command line always renders the same frames.
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <SPIFFS.h>
+#include <led_display.h>
+#include <patterns.h>
+#include <commands.h>
+#include <bench.h>
+#include "tetris_tune.h"
+#include "self_check.h"
+#include <map>
+#include <string>
+
+// Globals that main.cpp defines on the device
+uint8_t g_hue = 0;
+int g_Brightness = 96;
+int g_Speed = 120;
+uint8_t g_current_pattern_number = 0;
+uint32_t g_frameDeltaMs = 0;
+TaskHandle_t g_renderTask = nullptr;
+
+static CRGB leds[LED_MAX_LEDS];
+static uint8_t s_rgb[LED_MAX_LEDS * 3];   // one frame in row-major order
+
+struct SimOptions {
+  int pattern = -1;              // -1 runs them all
+  int frames = 300;
+  uint32_t seed = BENCH_DEFAULT_SEED;
+  const char* out = nullptr;     // raw RGB frames, "-" for stdout
+  const char* compare = nullptr; // checksum file from an earlier run
+  bool list = false;
+  bool checksum = false;
+  bool bench = false;
+  bool tetris = false;
+  bool check = false;
+  TetrisTuneOptions tune;
+};
+
+static void printLine(const char* line) {
+  printf("%s\n", line);
+}
+
+static void usage() {
+  fprintf(stderr,
+    "Usage: program [options]\n"
+    "  --list              list the patterns and exit\n"
+    "  --pattern NAME|N    run one pattern (default: all of them)\n"
+    "  --frames N          frames per pattern (default 300)\n"
+    "  --speed N           g_Speed, 0..255 (default 120)\n"
+    "  --seed N            random seed (default %u)\n"
+    "  --panel WxH         panel size (default %ux%u)\n"
+    "  --tiles XxY         panels across and down (default %ux%u)\n"
+    "  --data DIR          directory standing in for SPIFFS (default data)\n"
+    "  --out FILE|-        write frames as raw RGB24, row-major from the top left\n"
+    "  --checksum          print a checksum of each pattern's frames\n"
+    "  --compare FILE      compare checksums with an earlier --checksum run\n"
+    "  --bench             benchmark every pattern (see lib/bench), --frames each\n"
+    "  --check             check the Game of Life and Tetris bitboards against plain versions\n"
+    "  --tetris GAMES      play Tetris AI games headless and report how long they last\n"
+    "    --tune ROUNDS     then search for better AI weights for ROUNDS steps\n"
+    "    --weights L,H,B,A,M,W  start from these weights (see TetrisWeights)\n"
+    "    --lookahead       let the AI see the next piece\n"
+    "    --max-pieces N    stop a game after N pieces (default 2000)\n"
+    "    --threads N       worker threads (default: one per CPU)\n"
+    "  --verbose           show the firmware's Serial output\n",
+    BENCH_DEFAULT_SEED, LED_PANEL_WIDTH, LED_PANEL_HEIGHT, LED_TILES_X, LED_TILES_Y);
+}
+
+static int findPattern(const char* arg) {
+  char* end;
+  long n = strtol(arg, &end, 10);
+  if (*end == 0) {
+    return n >= 0 && n < (long)PATTERN_COUNT ? n : -1;
+  }
+  for (size_t i = 0; i < PATTERN_COUNT; i++) {
+    if (strcasecmp(g_patternList[i].name, arg) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static bool parsePair(const char* arg, uint8_t* a, uint8_t* b) {
+  unsigned x, y;
+  if (sscanf(arg, "%ux%u", &x, &y) != 2 || x == 0 || y == 0 || x > 255 || y > 255) {
+    return false;
+  }
+  *a = x;
+  *b = y;
+  return true;
+}
+
+// Copy the presented frame out of strip order, so the output doesn't
+// depend on how the panels are wired
+static void captureFrame() {
+  CRGB frame[LED_MAX_LEDS];
+  led_snapshot(frame);
+  uint8_t* p = s_rgb;
+  for (uint16_t y = 0; y < LED_HEIGHT; y++) {
+    for (uint16_t x = 0; x < LED_WIDTH; x++) {
+      const CRGB& c = frame[XY(x, y)];
+      *p++ = c.r;
+      *p++ = c.g;
+      *p++ = c.b;
+    }
+  }
+}
+
+// Drive one pattern the way renderFrame() in main.cpp does, write its
+// frames to `out` if set, return an FNV-1a hash of all its frames
+static uint32_t runPattern(size_t index, const SimOptions& opt, FILE* out) {
+  randomSeed(opt.seed);
+  random16_set_seed(opt.seed);
+  fill_solid(leds, LED_MAX_LEDS, CRGB::Black);
+
+  beginPattern(index);
+  uint32_t lastFrameStart = millis();
+  size_t frameBytes = NUM_LEDS * 3;
+  uint32_t hash = 2166136261u;
+
+  for (int f = 0; f < opt.frames; f++) {
+    // Nothing feeds the queue here, but patterns may post to it themselves
+    Command cmd;
+    while (commandTake(&cmd)) {
+      free(cmd.text);
+    }
+
+    g_hue = millis() / 10;
+    uint32_t now = millis();
+    g_frameDeltaMs = now - lastFrameStart;
+    lastFrameStart = now;
+
+    setFrameDelay(1);
+    g_patternList[index].func(leds);
+    led_present(leds, g_Brightness);
+
+    captureFrame();
+    for (size_t i = 0; i < frameBytes; i++) {
+      hash = (hash ^ s_rgb[i]) * 16777619u;
+    }
+    if (out) {
+      fwrite(s_rgb, 1, frameBytes, out);
+    }
+
+    // Sleep until the next frame is due, as the render task would
+    uint32_t elapsed = millis() - lastFrameStart;
+    uint32_t wait = elapsed < g_frameDelay ? g_frameDelay - elapsed : 1;
+    simAdvanceMicros((uint64_t)wait * 1000);
+  }
+
+  endPattern(index);
+  return hash;
+}
+
+// Read "checksum name" lines written by --checksum
+static std::map<std::string, uint32_t> loadChecksums(const char* path) {
+  std::map<std::string, uint32_t> sums;
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "Can't read %s\n", path);
+    exit(2);
+  }
+  char line[128];
+  while (fgets(line, sizeof(line), f)) {
+    unsigned hash;
+    char name[96];
+    if (sscanf(line, "%x %95[^\n]", &hash, name) == 2) {
+      sums[name] = hash;
+    }
+  }
+  fclose(f);
+  return sums;
+}
+
+int main(int argc, char** argv) {
+  SimOptions opt;
+  bool verbose = false;
+  const char* tuneOption = nullptr;   // the first option that needs --tetris
+  LedGeometry g = g_geometry;
+
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    bool ok = true;
+    int n = value ? atoi(value) : 0;
+    if (!strcmp(a, "--help")) {
+      usage();
+      return 0;
+    } else if (!strcmp(a, "--list")) {
+      opt.list = true;
+    } else if (!strcmp(a, "--checksum")) {
+      opt.checksum = true;
+    } else if (!strcmp(a, "--bench")) {
+      opt.bench = true;
+    } else if (!strcmp(a, "--check")) {
+      opt.check = true;
+    } else if (!strcmp(a, "--verbose")) {
+      verbose = true;
+    } else if (!strcmp(a, "--lookahead")) {
+      opt.tune.lookahead = true;
+      tuneOption = tuneOption ? tuneOption : a;
+    } else if (!value) {
+      ok = false;
+    } else if (!strcmp(a, "--pattern")) {
+      opt.pattern = findPattern(value);
+      ok = opt.pattern >= 0;
+      i++;
+    } else if (!strcmp(a, "--frames")) {
+      opt.frames = atoi(value);
+      ok = opt.frames > 0;
+      i++;
+    } else if (!strcmp(a, "--speed")) {
+      g_Speed = constrain(atoi(value), 0, 255);
+      i++;
+    } else if (!strcmp(a, "--seed")) {
+      opt.seed = strtoul(value, nullptr, 0);
+      i++;
+    } else if (!strcmp(a, "--panel")) {
+      ok = parsePair(value, &g.panelWidth, &g.panelHeight);
+      i++;
+    } else if (!strcmp(a, "--tiles")) {
+      ok = parsePair(value, &g.tilesX, &g.tilesY);
+      i++;
+    } else if (!strcmp(a, "--data")) {
+      SPIFFS.setRoot(value);
+      i++;
+    } else if (!strcmp(a, "--out")) {
+      opt.out = value;
+      i++;
+    } else if (!strcmp(a, "--compare")) {
+      opt.compare = value;
+      i++;
+    } else if (!strcmp(a, "--tetris")) {
+      opt.tetris = true;
+      opt.tune.games = n;
+      ok = n > 0;
+      i++;
+    } else if (!strcmp(a, "--tune")) {
+      opt.tune.rounds = n;
+      ok = n >= 0;
+      tuneOption = tuneOption ? tuneOption : a;
+      i++;
+    } else if (!strcmp(a, "--weights")) {
+      opt.tune.weights = value;
+      tuneOption = tuneOption ? tuneOption : a;
+      i++;
+    } else if (!strcmp(a, "--max-pieces")) {
+      opt.tune.maxPieces = n;
+      ok = n > 0;
+      tuneOption = tuneOption ? tuneOption : a;
+      i++;
+    } else if (!strcmp(a, "--threads")) {
+      opt.tune.threads = n;
+      ok = n >= 0;
+      tuneOption = tuneOption ? tuneOption : a;
+      i++;
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      fprintf(stderr, "Bad argument: %s%s%s\n", a, value ? " " : "", value ? value : "");
+      usage();
+      return 2;
+    }
+  }
+
+  if (tuneOption && !opt.tetris) {
+    fprintf(stderr, "%s only applies with --tetris\n", tuneOption);
+    usage();
+    return 2;
+  }
+
+  if (!led_valid_geometry(g)) {
+    fprintf(stderr, "Unsupported geometry, at most %u LEDs\n", LED_MAX_LEDS);
+    return 2;
+  }
+  Serial.setQuiet(!verbose);
+  g_geometry = g;
+  led_setup();
+  SPIFFS.begin();
+
+  if (opt.tetris) {
+    opt.tune.seed = opt.seed;
+    return tetrisTune(opt.tune);
+  }
+
+  if (opt.check) {
+    return selfCheck(leds, opt.seed);
+  }
+
+  if (opt.list) {
+    for (size_t i = 0; i < PATTERN_COUNT; i++) {
+      printf("%2u  %s\n", (unsigned)i, g_patternList[i].name);
+    }
+    return 0;
+  }
+
+  FILE* out = nullptr;
+  if (opt.out) {
+    out = strcmp(opt.out, "-") == 0 ? stdout : fopen(opt.out, "wb");
+    if (!out) {
+      fprintf(stderr, "Can't write %s\n", opt.out);
+      return 2;
+    }
+  }
+
+  std::map<std::string, uint32_t> expected;
+  if (opt.compare) {
+    expected = loadChecksums(opt.compare);
+  }
+
+  if (opt.bench) {
+    benchRun(leds, min(opt.frames, BENCH_MAX_FRAMES), opt.seed, printLine);
+    benchPreview(leds, min(opt.frames, BENCH_MAX_FRAMES), opt.seed, printLine);
+    benchMath(min(opt.frames, BENCH_MAX_FRAMES), printLine);
+    benchTetris(min(opt.frames, BENCH_MAX_FRAMES), opt.seed, printLine);
+    return 0;
+  }
+
+  // Frames go to stdout with --out -, so checksums go to stderr then
+  FILE* report = out == stdout ? stderr : stdout;
+
+  int failures = 0;
+  size_t first = opt.pattern >= 0 ? opt.pattern : 0;
+  size_t last = opt.pattern >= 0 ? opt.pattern + 1 : PATTERN_COUNT;
+  for (size_t i = first; i < last; i++) {
+    const char* name = g_patternList[i].name;
+    uint32_t hash = runPattern(i, opt, out);
+
+    if (opt.checksum) {
+      fprintf(report, "%08x %s\n", (unsigned)hash, name);
+    }
+    if (opt.compare) {
+      auto it = expected.find(name);
+      if (it == expected.end()) {
+        fprintf(stderr, "NEW   %s\n", name);
+      } else if (it->second != hash) {
+        fprintf(stderr, "FAIL  %s\n", name);
+        failures++;
+      }
+    }
+  }
+
+  if (out && out != stdout) {
+    fclose(out);
+  }
+  if (opt.compare) {
+    fprintf(stderr, "%d pattern(s) changed\n", failures);
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,167 @@
+// Tetris AI tuning harness, run from the simulator with --tetris (see
+// sim_main.cpp). Every game is seeded, so a weight set always gets the
+// same score, and candidate weights are compared on the same piece
+// sequences.
+
+#include "tetris_tune.h"
+#include "tetris/tetris_ai.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+struct GameResult {
+  uint32_t pieces;
+  uint32_t lines;
+  bool won;       // still going after maxPieces
+};
+
+struct TuneScore {
+  double meanLines;
+  uint32_t won;
+};
+
+// Piece order: xorshift like the shim's random(), but one generator per
+// game so the threads don't share one
+static uint32_t nextRandom(uint32_t& state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+// One game, as tetris.cpp plays it in AI mode
+static GameResult playGame(uint32_t seed, const TetrisWeights& weights, const TetrisTuneOptions& opt) {
+  uint32_t rng = seed * 2654435761u + 1;
+  TetrisBoard board = {};
+  GameResult result = {0, 0, false};
+  uint8_t next = nextRandom(rng) % TETRIS_PIECES;
+
+  while (result.pieces < opt.maxPieces) {
+    TetrisPiece piece = tetrisSpawn(next);
+    next = nextRandom(rng) % TETRIS_PIECES;
+    TetrisPlan plan;
+    TetrisAIStats stats = {};
+    if (tetrisCollides(board, piece) ||
+        !tetrisAIPlan(board, piece, opt.lookahead ? next : -1, weights, &plan, &stats)) {
+      return result;
+    }
+    while (tetrisAIAdvance(board, plan, piece)) {}
+    result.lines += tetrisLock(board, piece);
+    result.pieces++;
+  }
+  result.won = true;
+  return result;
+}
+
+// Play opt.games games on all threads
+static std::vector<GameResult> playGames(const TetrisWeights& weights, const TetrisTuneOptions& opt) {
+  std::vector<GameResult> results(opt.games);
+  std::atomic<uint32_t> nextGame(0);
+  auto worker = [&]() {
+    for (uint32_t g = nextGame++; g < opt.games; g = nextGame++) {
+      results[g] = playGame(opt.seed + g, weights, opt);
+    }
+  };
+
+  unsigned threads = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; t++) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& t : pool) {
+    t.join();
+  }
+  return results;
+}
+
+static TuneScore score(const std::vector<GameResult>& results) {
+  TuneScore s = {0, 0};
+  for (const GameResult& r : results) {
+    s.meanLines += r.lines;
+    s.won += r.won;
+  }
+  s.meanLines /= results.size();
+  return s;
+}
+
+static void printDistribution(const char* name, std::vector<uint32_t> values) {
+  std::sort(values.begin(), values.end());
+  size_t n = values.size();
+  double mean = 0;
+  for (uint32_t v : values) mean += v;
+  mean /= n;
+  printf("  %-7s mean %8.1f  min %6u  p10 %6u  p50 %6u  p90 %6u  max %6u\n", name, mean,
+         values[0], values[n / 10], values[n / 2], values[(n * 9) / 10], values[n - 1]);
+}
+
+static void report(const TetrisWeights& w, const std::vector<GameResult>& results,
+                   const TetrisTuneOptions& opt) {
+  std::vector<uint32_t> lines, pieces;
+  for (const GameResult& r : results) {
+    lines.push_back(r.lines);
+    pieces.push_back(r.pieces);
+  }
+  printf("Weights {%d, %d, %d, %d, %d, %d}, %u games, %s, seed %u:\n", w.lines, w.holes,
+         w.bumpiness, w.aggregateHeight, w.maxHeight, w.wells, opt.games,
+         opt.lookahead ? "lookahead" : "greedy", (unsigned)opt.seed);
+  printDistribution("lines", lines);
+  printDistribution("pieces", pieces);
+  printf("  %u of %u games reached %u pieces\n", score(results).won, opt.games, opt.maxPieces);
+}
+
+static bool parseWeights(const char* text, TetrisWeights* w) {
+  int v[6];
+  if (sscanf(text, "%d,%d,%d,%d,%d,%d", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != 6) {
+    return false;
+  }
+  *w = TetrisWeights{(int16_t)v[0], (int16_t)v[1], (int16_t)v[2], (int16_t)v[3], (int16_t)v[4], (int16_t)v[5]};
+  return true;
+}
+
+static int16_t& weightAt(TetrisWeights& w, uint8_t i) {
+  int16_t* fields[] = {&w.lines, &w.holes, &w.bumpiness, &w.aggregateHeight, &w.maxHeight, &w.wells};
+  return *fields[i];
+}
+
+int tetrisTune(const TetrisTuneOptions& opt) {
+  TetrisWeights best = TETRIS_DEFAULT_WEIGHTS;
+  if (opt.weights && !parseWeights(opt.weights, &best)) {
+    fprintf(stderr, "Bad weights: %s\n", opt.weights);
+    return 2;
+  }
+
+  std::vector<GameResult> results = playGames(best, opt);
+  report(best, results, opt);
+  TuneScore bestScore = score(results);
+
+  // Hill climb: nudge one weight at a time and keep the change if the same
+  // games clear more lines on average
+  uint32_t rng = opt.seed ^ 0x9e3779b9u;
+  for (uint32_t round = 1; round <= opt.rounds; round++) {
+    TetrisWeights candidate = best;
+    uint8_t index = nextRandom(rng) % 6;
+    int16_t& w = weightAt(candidate, index);
+    int step = std::max(2, abs(w) / 4);
+    int delta = 1 + nextRandom(rng) % step;
+    w = constrain(w + (nextRandom(rng) & 1 ? delta : -delta), 0, 1000);
+
+    TuneScore s = score(playGames(candidate, opt));
+    if (s.meanLines > bestScore.meanLines) {
+      best = candidate;
+      bestScore = s;
+      printf("round %u: {%d, %d, %d, %d, %d, %d} %.1f lines, %u won\n", round, best.lines,
+             best.holes, best.bumpiness, best.aggregateHeight, best.maxHeight, best.wells,
+             s.meanLines, s.won);
+      fflush(stdout);
+    }
+  }
+
+  if (opt.rounds > 0) {
+    report(best, playGames(best, opt), opt);
+    printf("const TetrisWeights TETRIS_DEFAULT_WEIGHTS = {%d, %d, %d, %d, %d, %d};\n", best.lines,
+           best.holes, best.bumpiness, best.aggregateHeight, best.maxHeight, best.wells);
+  }
+  return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef TETRIS_TUNE_H
+#define TETRIS_TUNE_H
+
+#include <Arduino.h>
+
+// Headless Tetris for the AI: plays whole games with the rules in
+// lib/patterns/tetris/tetris_ai, many at once on worker threads, and
+// reports how long they lasted. With rounds > 0 it also searches for
+// better TetrisWeights and prints the best set as a C initializer.
+
+struct TetrisTuneOptions {
+  uint32_t games = 200;          // per evaluation of a weight set
+  uint32_t maxPieces = 2000;     // a game that lasts this long counts as won
+  uint32_t rounds = 0;           // weight search steps, 0 just plays
+  uint32_t seed = 1;             // game g uses seed + g
+  unsigned threads = 0;          // 0: one per CPU
+  bool lookahead = false;
+  const char* weights = nullptr; // "lines,holes,bumpiness,height,max,wells"
+};
+
+// Returns the process exit code
+int tetrisTune(const TetrisTuneOptions& options);
+
+#endif // TETRIS_TUNE_H
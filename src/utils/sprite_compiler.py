@@ -0,0 +1,335 @@
+#!/usr/bin/env python3
+"""
+Compile PNG sprite sheets into the compact sprite format read by
+lib/sprites (see sprites.h for the byte layout).
+
+Each sheet in the manifest is a horizontal strip of equally sized frames.
+The manifest picks which strip frames to play, in what order and for how
+long, e.g.
+
+    {
+      "header": "../../../lib/patterns/game_sprites.h",
+      "data": "../../../data/sprites",
+      "sheets": [
+        {
+          "name": "pacSheet",
+          "description": "Pac-Man chomping",
+          "image": "pac.png",
+          "frameWidth": 16,
+          "frameHeight": 16,
+          "colors": 16,
+          "frames": [ {"frame": 0, "ms": 200}, {"frame": 2, "ms": 200} ]
+        }
+      ]
+    }
+
+Paths are relative to the manifest. "colors" is optional: without it a
+sheet keeps its exact colors when there are 256 or fewer, and is
+quantized to 256 otherwise. Frames are stored as deltas from the previous
+frame unless that is noticeably bigger; set "delta": false for sheets that are
+drawn by frame number (spriteDrawFrame) rather than played in order.
+
+Sheets with "target": "spiffs" are not compiled into the firmware. They
+are written to the manifest's "data" directory as <name>.pxs and streamed
+from SPIFFS at runtime (spriteStreamOpen), so they can be replaced with
+`pio run -t uploadfs` or the /animation page without reflashing.
+
+Usage:
+    python3 sprite_compiler.py sprites/sprites.json [--bin DIR]
+
+Writes the C header named in the manifest, the SPIFFS sheets and, with
+--bin, a .pxs file for every sheet.
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+from PIL import Image
+
+SPRITE_VERSION = 1
+FRAME_KEY = 0
+FRAME_REPEAT = 1
+FRAME_DELTA = 2
+
+# Size of the same frame as a `const long[w*h]` PROGMEM table
+LEGACY_BYTES_PER_PIXEL = 4
+
+
+def pixels_of(img):
+    data = img.tobytes()
+    return [tuple(data[i:i + 3]) for i in range(0, len(data), 3)]
+
+
+def load_frames(sheet, base_dir):
+    """Return the manifest's frames as lists of (r, g, b) in row-major order."""
+    img = Image.open(os.path.join(base_dir, sheet["image"])).convert("RGB")
+    fw = sheet.get("frameWidth", 16)
+    fh = sheet.get("frameHeight", 16)
+    if img.height < fh or img.width % fw != 0:
+        raise ValueError(f"{sheet['image']}: {img.width}x{img.height} is not a strip of {fw}x{fh} frames")
+
+    strip = []
+    for f in range(img.width // fw):
+        frame = img.crop((f * fw, 0, (f + 1) * fw, fh))
+        strip.append(pixels_of(frame))
+
+    sequence = []
+    for entry in sheet["frames"]:
+        index = entry["frame"]
+        if index >= len(strip):
+            raise ValueError(f"{sheet['name']}: frame {index} out of range, strip has {len(strip)}")
+        sequence.append((strip[index], int(entry.get("ms", 0))))
+    return fw, fh, sequence
+
+
+def quantize(sequence, fw, fh, colors):
+    """Map all frames onto one shared palette of at most `colors` entries."""
+    # Lay the frames out side by side so they share a single palette
+    combined = Image.new("RGB", (fw * len(sequence), fh))
+    for i, (pixels, _) in enumerate(sequence):
+        frame = Image.new("RGB", (fw, fh))
+        frame.putdata(pixels)
+        combined.paste(frame, (i * fw, 0))
+
+    reduced = combined.quantize(colors=colors, method=Image.Quantize.MEDIANCUT).convert("RGB")
+    result = []
+    for i, (_, ms) in enumerate(sequence):
+        frame = reduced.crop((i * fw, 0, (i + 1) * fw, fh))
+        result.append((pixels_of(frame), ms))
+    return result
+
+
+def build_palette(sequence):
+    palette = []
+    seen = set()
+    for pixels, _ in sequence:
+        for c in pixels:
+            if c not in seen:
+                seen.add(c)
+                palette.append(c)
+    # Keep black at index 0 so it is the cheapest background to encode
+    palette.sort(key=lambda c: c != (0, 0, 0))
+    return palette
+
+
+def index_bits(palette_size):
+    bits = max(1, (palette_size - 1).bit_length())
+    return bits if bits <= 4 else 8
+
+
+def max_run(bits):
+    return 256 if bits == 8 else 1 << (8 - bits)
+
+
+def encode_token(index, run, bits):
+    if bits == 8:
+        return bytes([run - 1, index])
+    return bytes([(index << (8 - bits)) | (run - 1)])
+
+
+def encode_key(indices, bits):
+    """Run-length encode one frame of palette indices."""
+    out = bytearray()
+    i = 0
+    while i < len(indices):
+        j = i
+        while j < len(indices) and indices[j] == indices[i] and j - i < max_run(bits):
+            j += 1
+        out += encode_token(indices[i], j - i, bits)
+        i = j
+    return bytes(out)
+
+
+def encode_delta(prev, indices, bits):
+    """Encode only the pixels that differ from the previous frame."""
+    out = bytearray()
+    pos = 0        # first pixel not yet covered
+    i = 0
+    while i < len(indices):
+        if indices[i] == prev[i]:
+            i += 1
+            continue
+        skip = i - pos
+        while skip >= 255:
+            out.append(255)
+            skip -= 255
+        out.append(skip)
+        # Let the run carry on over unchanged pixels of the same color,
+        # rewriting them is free and saves starting a new run
+        j = i
+        while j < len(indices) and indices[j] == indices[i] and j - i < max_run(bits):
+            j += 1
+        out += encode_token(indices[i], j - i, bits)
+        pos = i = j
+    return bytes(out)
+
+
+def dedupe(sequence):
+    """Fold back-to-back identical frames into one longer frame."""
+    result = []
+    for pixels, ms in sequence:
+        if result and result[-1][0] == pixels:
+            result[-1] = (pixels, result[-1][1] + ms)
+        else:
+            result.append((pixels, ms))
+    return result
+
+
+def compile_sheet(sheet, base_dir):
+    fw, fh, sequence = load_frames(sheet, base_dir)
+    if fw > 255 or fh > 255:
+        raise ValueError(f"{sheet['name']}: frames larger than 255 pixels are not supported")
+
+    unique = {c for pixels, _ in sequence for c in pixels}
+    colors = min(sheet.get("colors", 256), 256)
+    lossy = len(unique) > colors
+    if lossy:
+        sequence = quantize(sequence, fw, fh, colors)
+
+    sequence = dedupe(sequence)
+    if len(sequence) > 255:
+        raise ValueError(f"{sheet['name']}: more than 255 frames")
+
+    palette = build_palette(sequence)
+    lut = {c: i for i, c in enumerate(palette)}
+    bits = index_bits(len(palette))
+
+    out = bytearray(b"PX")
+    out += bytes([SPRITE_VERSION, fw, fh, len(sequence), len(palette) - 1, bits])
+    for r, g, b in palette:
+        out += bytes([r, g, b])
+
+    # Frames that reappear later in the loop are stored once and referenced,
+    # everything else is a key frame or a delta from the previous frame
+    use_delta = sheet.get("delta", True)
+    key_frames = {}
+    counts = {FRAME_KEY: 0, FRAME_REPEAT: 0, FRAME_DELTA: 0}
+    prev = None
+    for n, (pixels, ms) in enumerate(sequence):
+        indices = [lut[c] for c in pixels]
+        key = tuple(indices)
+        if key in key_frames:
+            frame_type, payload = FRAME_REPEAT, bytes([key_frames[key]])
+        else:
+            frame_type, payload = FRAME_KEY, encode_key(indices, bits)
+            if use_delta and prev is not None:
+                # Deltas also touch fewer pixels at playback, so take one
+                # even when it is up to an eighth larger than the key frame
+                delta = encode_delta(prev, indices, bits)
+                if len(delta) <= len(payload) + len(payload) // 8:
+                    frame_type, payload = FRAME_DELTA, delta
+            if frame_type == FRAME_KEY:
+                key_frames[key] = n
+        counts[frame_type] += 1
+        out += struct.pack("<HBH", ms, frame_type, len(payload)) + payload
+        prev = indices
+
+    legacy = len(sheet["frames"]) * fw * fh * LEGACY_BYTES_PER_PIXEL
+    stats = {
+        "frames": len(sheet["frames"]),
+        "keys": counts[FRAME_KEY],
+        "deltas": counts[FRAME_DELTA],
+        "colors": len(palette),
+        "lossy": lossy,
+        "bytes": len(out),
+        "legacy": legacy,
+    }
+    return bytes(out), stats
+
+
+def on_spiffs(sheet):
+    return sheet.get("target", "flash") == "spiffs"
+
+
+def format_header(manifest_path, compiled):
+    lines = [
+        "#ifndef GAME_SPRITES_H",
+        "#define GAME_SPRITES_H",
+        "",
+        "// Sprite sheets for the game character patterns, in the format described",
+        "// in lib/sprites/sprites.h. Sheets marked for SPIFFS live in data/sprites.",
+        "//",
+        "// Generated by src/utils/sprite_compiler.py from",
+        f"// src/utils/sprites/{os.path.basename(manifest_path)} - edit the PNGs and manifest, not this file.",
+        "",
+        "#include <Arduino.h>",
+        "",
+    ]
+    for sheet, data, stats in compiled:
+        if on_spiffs(sheet):
+            continue
+        lines.append(f"// {sheet.get('description', sheet['name'])} ({stats['frames']} frames, {len(data)} bytes)")
+        lines.append(f"static const uint8_t {sheet['name']}[] PROGMEM = {{")
+        for i in range(0, len(data), 16):
+            lines.append("  " + ",".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+    lines.append("#endif // GAME_SPRITES_H")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile PNG sprite sheets for PixelBoard")
+    parser.add_argument("manifest", help="JSON manifest describing the sheets")
+    parser.add_argument("--bin", metavar="DIR", help="also write one .pxs file per sheet into DIR")
+    args = parser.parse_args()
+
+    base_dir = os.path.dirname(os.path.abspath(args.manifest))
+    with open(args.manifest) as f:
+        manifest = json.load(f)
+
+    compiled = []
+    for sheet in manifest["sheets"]:
+        data, stats = compile_sheet(sheet, base_dir)
+        compiled.append((sheet, data, stats))
+
+    header = os.path.join(base_dir, manifest["header"])
+    with open(header, "w") as f:
+        f.write(format_header(args.manifest, compiled))
+
+    written = [header]
+    spiffs = [entry for entry in compiled if on_spiffs(entry[0])]
+    if spiffs:
+        if "data" not in manifest:
+            raise ValueError("manifest needs a \"data\" directory for SPIFFS sheets")
+        data_dir = os.path.join(base_dir, manifest["data"])
+        os.makedirs(data_dir, exist_ok=True)
+        for sheet, data, _ in spiffs:
+            # SPIFFS names are limited to 31 characters including the path
+            if len("/sprites/" + sheet["name"] + ".pxs") > 31:
+                raise ValueError(f"{sheet['name']}: name too long for SPIFFS")
+            path = os.path.join(data_dir, sheet["name"] + ".pxs")
+            with open(path, "wb") as f:
+                f.write(data)
+            written.append(path)
+
+    if args.bin:
+        os.makedirs(args.bin, exist_ok=True)
+        for sheet, data, _ in compiled:
+            with open(os.path.join(args.bin, sheet["name"] + ".pxs"), "wb") as f:
+                f.write(data)
+
+    totals = {"flash": [0, 0], "spiffs": [0, 0]}
+    print(f"{'sheet':<14}{'frames':>7}{'keys':>6}{'deltas':>7}{'colors':>7}{'bytes':>8}{'legacy':>8}{'saved':>8}")
+    for sheet, data, s in compiled:
+        note = " (quantized)" if s["lossy"] else ""
+        if on_spiffs(sheet):
+            note += " (SPIFFS)"
+        print(f"{sheet['name']:<14}{s['frames']:>7}{s['keys']:>6}{s['deltas']:>7}{s['colors']:>7}"
+              f"{s['bytes']:>8}{s['legacy']:>8}{s['legacy'] - s['bytes']:>8}{note}")
+        total = totals["spiffs" if on_spiffs(sheet) else "flash"]
+        total[0] += s["bytes"]
+        total[1] += s["legacy"]
+    for target, (total_bytes, total_legacy) in totals.items():
+        if total_bytes:
+            print(f"{'total ' + target:<41}{total_bytes:>8}{total_legacy:>8}{total_legacy - total_bytes:>8}")
+    for path in written:
+        print(f"Wrote {os.path.relpath(path)}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
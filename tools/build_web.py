@@ -0,0 +1,97 @@
+# Build step for the web UI: minifies and gzips every file in web/ into
+# lib/webassets/web_pages.h and web_pages.cpp, so the firmware can serve
+# the pages straight from flash. PlatformIO runs it before each build
+# (extra_scripts in platformio.ini); it can also be run by hand with
+# python3 tools/build_web.py.
+#
+# The files are only rewritten when their contents change, so an
+# unchanged UI doesn't trigger a rebuild.
+
+import gzip
+import hashlib
+import os
+import re
+
+CONTENT_TYPES = {
+    ".html": "text/html; charset=utf-8",
+    ".js": "application/javascript",
+    ".css": "text/css",
+}
+
+
+def minify(text):
+    # Conservative, line by line: indentation, blank lines and whole-line
+    # comments go, line breaks stay so no statement can run into the next.
+    # gzip does the rest.
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        if line.startswith("<!--") and line.endswith("-->"):
+            continue
+        lines.append(line)
+    return "\n".join(lines) + "\n"
+
+
+def symbol(name):
+    return "WEB_" + re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def write_if_changed(path, text):
+    if os.path.exists(path):
+        with open(path, encoding="utf-8") as f:
+            if f.read() == text:
+                return
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+    print("build_web: wrote " + os.path.relpath(path))
+
+
+def build(root):
+    web_dir = os.path.join(root, "web")
+    out_dir = os.path.join(root, "lib", "webassets")
+
+    header = [
+        "// Generated by tools/build_web.py from web/; edit those files instead.",
+        "#ifndef WEB_PAGES_H",
+        "#define WEB_PAGES_H",
+        "",
+    ]
+    source = [
+        "// Generated by tools/build_web.py from web/; edit those files instead.",
+        "#include \"webassets.h\"",
+    ]
+    for name in sorted(os.listdir(web_dir)):
+        content_type = CONTENT_TYPES.get(os.path.splitext(name)[1])
+        if not content_type:
+            continue
+        with open(os.path.join(web_dir, name), encoding="utf-8") as f:
+            text = f.read()
+        raw = minify(text).encode("utf-8")
+        # mtime 0 keeps the output, and so the ETag, the same from build to build
+        data = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = hashlib.sha1(data).hexdigest()[:16]
+
+        sym = symbol(name)
+        header.append("extern const WebAsset %s;  // %s: %d bytes, %d minified, %d gzipped"
+                      % (sym, name, len(text.encode("utf-8")), len(raw), len(data)))
+        source.append("")
+        source.append("static const uint8_t %s_DATA[] PROGMEM = {" % sym)
+        for i in range(0, len(data), 16):
+            source.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+        source.append("};")
+        source.append("const WebAsset %s = {\"%s\", %s_DATA, sizeof(%s_DATA), \"\\\"%s\\\"\"};"
+                      % (sym, content_type, sym, sym, etag))
+
+    header += ["", "#endif // WEB_PAGES_H", ""]
+    source.append("")
+    write_if_changed(os.path.join(out_dir, "web_pages.h"), "\n".join(header))
+    write_if_changed(os.path.join(out_dir, "web_pages.cpp"), "\n".join(source))
+
+
+try:
+    Import("env")
+    build(env.subst("$PROJECT_DIR"))
+except NameError:
+    build(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
@@ -0,0 +1,135 @@
+const PixelPreview = {
+  interval: 100,
+  sequence: 0,     // preview we hold, 0 for none
+  pixels: new Uint8Array(768),
+  socket: null,
+  pollTimer: null,
+  polling: false,
+  paused: false,
+  onFrame: null,   // optional, called after each change is painted
+
+  // The grid may be new, so this starts from a keyframe
+  start(ms) {
+    this.stop();
+    this.interval = ms;
+    this.sequence = 0;
+    this.paused = false;
+    this.connect();
+  },
+
+  // Change the update rate; the device caps what it pushes accordingly
+  setInterval(ms) {
+    this.interval = ms;
+    if (this.socket && this.socket.readyState === WebSocket.OPEN) {
+      this.socket.send('interval=' + ms);
+    }
+    if (this.pollTimer) {
+      this.startPolling();
+    }
+  },
+
+  stop() {
+    this.paused = true;
+    this.stopPolling();
+    if (this.socket) {
+      this.socket.onclose = null;
+      this.socket.close();
+      this.socket = null;
+    }
+  },
+
+  paintPixel(i) {
+    const el = document.getElementById('pixel-' + i);
+    if (el) {
+      const p = this.pixels;
+      el.style.backgroundColor = `rgb(${p[i * 3]},${p[i * 3 + 1]},${p[i * 3 + 2]})`;
+    }
+  },
+
+  // Apply one message: [type][sequence u32], then 768 RGB bytes for a
+  // keyframe, or [base u32] and runs of [first][count][RGB...] for a delta
+  apply(buffer) {
+    const data = new Uint8Array(buffer);
+    const view = new DataView(buffer);
+    if (data.length < 5) return;
+    const type = data[0];
+    const sequence = view.getUint32(1, true);
+    if (type === 1 && data.length === 5 + 768) {
+      this.pixels.set(data.subarray(5));
+      for (let i = 0; i < 256; i++) this.paintPixel(i);
+    } else if (type === 2 && data.length >= 9) {
+      if (view.getUint32(5, true) !== this.sequence) {
+        this.resync();
+        return;
+      }
+      for (let at = 9; at + 2 <= data.length;) {
+        const first = data[at], count = data[at + 1];
+        this.pixels.set(data.subarray(at + 2, at + 2 + count * 3), first * 3);
+        for (let i = first; i < first + count; i++) this.paintPixel(i);
+        at += 2 + count * 3;
+      }
+    } else if (type !== 0) {
+      return;
+    }
+    this.sequence = sequence;
+    if (type !== 0 && this.onFrame) this.onFrame();
+  },
+
+  // Lost track; ask for a keyframe
+  resync() {
+    this.sequence = 0;
+    if (this.socket && this.socket.readyState === WebSocket.OPEN) {
+      this.socket.send('since=0');
+    }
+  },
+
+  connect() {
+    if (!('WebSocket' in window)) {
+      this.startPolling();
+      return;
+    }
+    const socket = new WebSocket(`ws://${location.host}/previewws`);
+    socket.binaryType = 'arraybuffer';
+    socket.onopen = () => {
+      this.stopPolling();
+      socket.send(`interval=${this.interval}&since=${this.sequence}`);
+    };
+    socket.onmessage = (event) => {
+      if (typeof event.data !== 'string') this.apply(event.data);
+    };
+    socket.onclose = () => {
+      // The board may have restarted and numbered its previews afresh.
+      // Poll meanwhile, and try the socket again in a while.
+      this.socket = null;
+      this.sequence = 0;
+      if (this.paused) return;
+      this.startPolling();
+      setTimeout(() => { if (!this.paused && !this.socket) this.connect(); }, 5000);
+    };
+    this.socket = socket;
+  },
+
+  poll() {
+    if (this.polling) return;   // previous request still in flight
+    this.polling = true;
+    fetch('/pixelStatus?since=' + this.sequence)
+      .then(response => response.arrayBuffer())
+      .then(buffer => this.apply(buffer))
+      .catch(error => {
+        console.error('Error updating preview:', error);
+        this.sequence = 0;
+      })
+      .finally(() => { this.polling = false; });
+  },
+
+  startPolling() {
+    this.stopPolling();
+    this.poll();
+    this.pollTimer = setInterval(() => this.poll(), this.interval);
+  },
+
+  stopPolling() {
+    if (this.pollTimer) clearInterval(this.pollTimer);
+    this.pollTimer = null;
+  }
+};